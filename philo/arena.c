@@ -0,0 +1,154 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   arena.c                                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: imunaev- <imunaev-@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/03/25 16:08:12 by imunaev-          #+#    #+#             */
+/*   Updated: 2025/03/25 16:08:12 by imunaev-         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file arena.c
+ * @brief Single memory arena holding the environment, philosophers and forks.
+ *
+ * The arena is one anonymous mapping sized up front from the philosopher
+ * count and the fork mode. Large arenas are backed by huge pages when the
+ * system has them reserved, and otherwise ask for transparent huge pages.
+ * Sub-regions are carved at cache-line boundaries, so no two of them share
+ * a line, and every page is faulted in before the threads start.
+ */
+
+#include "philo.h"
+#include <sys/mman.h>
+
+/**
+ * @brief Rounds `size` up to a multiple of `align` (a power of two).
+ *
+ * @param size Size in bytes.
+ * @param align Alignment in bytes.
+ * @return size_t The rounded size.
+ */
+static size_t	align_up(size_t size, size_t align)
+{
+	return ((size + align - 1) & ~(align - 1));
+}
+
+/**
+ * @brief Computes the arena size for `n` philosophers.
+ *
+ * Mirrors the carving order: `t_env` (see `init_program()`), the
+ * philosopher array, the hot `last_meal`, `deadline` and `meals` arrays,
+ * the latency histograms with `--report`, then either the fork mutexes or
+ * the fork bitmap with its waiter counts (see `init_forks_philos()`), and
+ * the fork lock counters with `--lockstat`.
+ *
+ * @param opts Run-time options.
+ * @param n Number of philosophers.
+ * @return size_t Size of the arena in bytes.
+ */
+static size_t	arena_bytes(const t_opts *opts, int n)
+{
+	size_t	size;
+	size_t	words;
+
+	size = align_up(sizeof(t_env), CACHE_LINE)
+		+ align_up(n * sizeof(t_philo), CACHE_LINE)
+		+ align_up(n * sizeof(long), CACHE_LINE)
+		+ align_up(n * sizeof(long), CACHE_LINE)
+		+ align_up(n * sizeof(int), CACHE_LINE);
+	if (opts->report)
+		size += align_up(n * sizeof(t_latency), CACHE_LINE);
+	if (opts->lockstat && opts->fork_mode == FORK_MUTEX)
+		size += align_up(2 * n * sizeof(t_lock_stat), CACHE_LINE);
+	if (opts->fork_mode == FORK_MUTEX)
+		return (size + align_up(n * sizeof(pthread_mutex_t), CACHE_LINE));
+	words = (n + FORK_WORD_BITS - 1) / FORK_WORD_BITS;
+	return (size + align_up(words * sizeof(_Atomic uint64_t), CACHE_LINE)
+		+ align_up(words * sizeof(atomic_int), CACHE_LINE));
+}
+
+/**
+ * @brief Maps the arena for `n` philosophers, preferring huge pages.
+ *
+ * `MAP_HUGETLB` only succeeds when huge pages are reserved; otherwise the
+ * arena falls back to base pages and, if large, is marked for transparent
+ * huge pages. The mapping is zero-filled but not populated here, so that
+ * NUMA placement can still bind it before it is first written.
+ *
+ * @param a Arena descriptor filled with the mapping.
+ * @param opts Run-time options.
+ * @param n Number of philosophers.
+ * @return int Returns EXIT_SUCCESS on success, otherwise EXIT_FAILURE.
+ */
+int	arena_map(t_arena *a, const t_opts *opts, int n)
+{
+	size_t	size;
+
+	size = arena_bytes(opts, n);
+	a->size = align_up(size, ARENA_HUGE_PAGE);
+	a->backing = ARENA_HUGETLB;
+	a->base = MAP_FAILED;
+	if (size >= ARENA_HUGE_PAGE)
+		a->base = mmap(NULL, a->size, PROT_READ | PROT_WRITE,
+				MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+	if (a->base == MAP_FAILED)
+	{
+		a->size = align_up(size, sysconf(_SC_PAGESIZE));
+		a->base = mmap(NULL, a->size, PROT_READ | PROT_WRITE,
+				MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+		a->backing = ARENA_PAGES;
+		if (a->base != MAP_FAILED && size >= ARENA_HUGE_PAGE
+			&& madvise(a->base, a->size, MADV_HUGEPAGE) == 0)
+			a->backing = ARENA_THP;
+	}
+	a->used = 0;
+	a->keep = false;
+	return (a->base == MAP_FAILED);
+}
+
+/**
+ * @brief Carves a cache-line aligned region of `size` bytes.
+ *
+ * @param a Pointer to the arena.
+ * @param size Size of the region in bytes.
+ * @return void* Start of the region, or NULL if the arena is exhausted.
+ */
+void	*arena_carve(t_arena *a, size_t size)
+{
+	void	*p;
+
+	if (a->used + align_up(size, CACHE_LINE) > a->size)
+		return (NULL);
+	p = (char *)a->base + a->used;
+	a->used += align_up(size, CACHE_LINE);
+	return (p);
+}
+
+/**
+ * @brief Faults in every page of the arena.
+ *
+ * Called once setup is done and before the simulation threads start, so
+ * that pages already first-touched by the spawners keep their node and the
+ * rest are faulted in now instead of during the simulation. Each page is
+ * written, since reading would only map the shared zero page.
+ *
+ * @param a Pointer to the arena.
+ */
+void	arena_prefault(t_arena *a)
+{
+	volatile char	*p;
+	size_t			page;
+	size_t			off;
+
+	p = (volatile char *)a->base;
+	page = sysconf(_SC_PAGESIZE);
+	off = 0;
+	while (off < a->size)
+	{
+		p[off] = p[off];
+		off += page;
+	}
+}
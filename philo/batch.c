@@ -0,0 +1,216 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   batch.c                                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: imunaev- <imunaev-@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 15:10:03 by imunaev-          #+#    #+#             */
+/*   Updated: 2026/10/19 15:10:03 by imunaev-         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file batch.c
+ * @brief `--batch`: many simulations in one process.
+ *
+ * Each of the `--jobs` runners maps one arena, sized for the largest run
+ * of the batch, and reuses it for every run it claims: the part the last
+ * run carved is zeroed and the next environment is carved from the start
+ * again, so a run costs no mapping and no page faults. Likewise every
+ * runner keeps one thread crew (see `crew.c`), sized for the largest run,
+ * and hands it each new environment, so a run creates and joins no
+ * thread. Runs are quiet:
+ * they buffer no status lines and start no logger thread, and only their
+ * summary line is printed (see `batch_summary()`).
+ */
+
+#include "philo.h"
+#include <sys/mman.h>
+
+/**
+ * @brief Runs configuration `i` in the runner's arena, on its crew.
+ *
+ * Mirrors `main()` and `init_program()`, except that the arena is not
+ * mapped for the run and stays mapped after it (`keep`), and the run's
+ * threads come from the crew. `a->used` is left at the size the run
+ * carved, which the next run zeroes.
+ *
+ * @param b The batch.
+ * @param a The runner's arena.
+ * @param crew The runner's crew.
+ * @param i Index of the run.
+ * @return int Returns EXIT_SUCCESS if the run completed, otherwise
+ * EXIT_FAILURE.
+ */
+static int	run_one(t_batch *b, t_arena *a, t_crew *crew, int i)
+{
+	t_env		*env;
+	pthread_t	logger_thread;
+	int			status;
+
+	memset(a->base, 0, a->used);
+	a->used = 0;
+	env = arena_carve(a, sizeof(t_env));
+	env->arena = *a;
+	env->arena.keep = true;
+	env->crew = crew;
+	env->opts = b->opts;
+	status = init_env(env, b->runs[i].ac, b->runs[i].av);
+	logger_thread = 0;
+	if (status == EXIT_SUCCESS)
+		status = start_threads(env, &logger_thread);
+	join_threads(env, logger_thread);
+	if (status == EXIT_SUCCESS)
+		batch_summary(b, i, env);
+	else
+		batch_summary(b, i, NULL);
+	a->used = env->arena.used;
+	free_all(env);
+	return (status);
+}
+
+/**
+ * @brief Maps the arena of a runner and prepares its crew.
+ *
+ * A run needs at most one thread per philosopher (or fewer pool workers
+ * or carriers) plus one per monitor shard.
+ *
+ * @param b The batch.
+ * @param a The arena to map.
+ * @param crew The crew to prepare.
+ * @return int Returns EXIT_SUCCESS if both are ready, otherwise
+ * EXIT_FAILURE.
+ */
+static int	setup_runner(t_batch *b, t_arena *a, t_crew *crew)
+{
+	int	shards;
+
+	if (arena_map(a, &b->opts, b->max_philo) == EXIT_FAILURE)
+	{
+		print_error("Error: batch_runner: arena mem alloc failed\n");
+		return (EXIT_FAILURE);
+	}
+	shards = b->opts.shards;
+	if (shards > b->max_philo)
+		shards = b->max_philo;
+	if (crew_init(crew, &b->opts, b->max_philo + shards) == EXIT_FAILURE)
+	{
+		print_error("Error: batch_runner: crew alloc failed\n");
+		(void)munmap(a->base, a->size);
+		return (EXIT_FAILURE);
+	}
+	return (EXIT_SUCCESS);
+}
+
+/**
+ * @brief Runner: claims runs in file order until none is left.
+ *
+ * Thread safety:
+ * - `next` hands every run to exactly one runner.
+ * - `failed` is set when a run is invalid or fails.
+ *
+ * @param arg Pointer to the batch (`t_batch`).
+ * @return NULL when the batch is done.
+ */
+static void	*batch_runner(void *arg)
+{
+	t_batch	*b;
+	t_arena	arena;
+	t_crew	crew;
+	int		i;
+
+	b = (t_batch *)arg;
+	if (setup_runner(b, &arena, &crew) == EXIT_FAILURE)
+	{
+		atomic_store(&b->failed, 1);
+		return (NULL);
+	}
+	i = atomic_fetch_add(&b->next, 1);
+	while (i < b->count)
+	{
+		if (!b->runs[i].valid)
+			batch_summary(b, i, NULL);
+		if (!b->runs[i].valid || run_one(b, &arena, &crew, i) == EXIT_FAILURE)
+			atomic_store(&b->failed, 1);
+		i = atomic_fetch_add(&b->next, 1);
+	}
+	crew_stop(&crew);
+	(void)munmap(arena.base, arena.size);
+	return (NULL);
+}
+
+/**
+ * @brief Starts `--jobs` runners, the calling thread being one of them,
+ * and waits for them.
+ *
+ * If a runner thread fails to create, the runners already going still
+ * complete the batch.
+ *
+ * @param b The batch.
+ * @return int Returns EXIT_SUCCESS if every runner was started, otherwise
+ * EXIT_FAILURE.
+ */
+static int	start_runners(t_batch *b)
+{
+	pthread_t	*threads;
+	int			created;
+	int			i;
+
+	threads = malloc(b->opts.jobs * sizeof(pthread_t));
+	created = 1;
+	while (threads && created < b->opts.jobs && created < b->count
+		&& pthread_create(&threads[created], NULL, batch_runner, b) == 0)
+		created++;
+	batch_runner(b);
+	i = 1;
+	while (i < created)
+	{
+		pthread_join(threads[i], NULL);
+		i++;
+	}
+	free(threads);
+	if (created < b->opts.jobs && created < b->count)
+	{
+		print_error("Error: start_runners: failed to create runner thread\n");
+		return (EXIT_FAILURE);
+	}
+	return (EXIT_SUCCESS);
+}
+
+/**
+ * @brief Runs every configuration of the `--batch` file.
+ *
+ * The instruments that write per-run files, shared memory or reports to
+ * stderr (`--live`, `--trace`, `--record`, `--replay`, `--report` and
+ * `--lockstat`) cannot be combined with it.
+ *
+ * @param opts Run-time options, with `opts->batch` set.
+ * @return int Returns EXIT_SUCCESS if every run was valid and completed,
+ * otherwise EXIT_FAILURE.
+ */
+int	run_batch(t_opts *opts)
+{
+	t_batch	b;
+	int		status;
+
+	if (opts->live || opts->trace || opts->record || opts->replay
+		|| opts->report || opts->lockstat)
+	{
+		print_error("Error: --batch cannot be combined with --live, "
+			"--trace, --record, --replay, --report or --lockstat\n");
+		return (EXIT_FAILURE);
+	}
+	b.opts = *opts;
+	b.opts.quiet = true;
+	if (load_batch(&b) == EXIT_FAILURE)
+		return (EXIT_FAILURE);
+	atomic_init(&b.next, 0);
+	atomic_init(&b.failed, 0);
+	status = start_runners(&b);
+	free(b.runs);
+	free(b.text);
+	if (atomic_load(&b.failed))
+		return (EXIT_FAILURE);
+	return (status);
+}
@@ -0,0 +1,170 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   batch_load.c                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: imunaev- <imunaev-@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 14:52:30 by imunaev-          #+#    #+#             */
+/*   Updated: 2026/10/19 14:52:30 by imunaev-         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file batch_load.c
+ * @brief Loading of a `--batch` file.
+ *
+ * The file holds one configuration per line, `num die eat sleep [meals]`
+ * as for a single run. Blank lines and `#` comments are skipped. The
+ * lines are split in place, so the runs point into the loaded text.
+ */
+
+#include "philo.h"
+
+/**
+ * @brief Cuts the next blank-separated token of a line.
+ *
+ * Spaces, tabs and carriage returns separate the tokens. Also used to
+ * read the `--scenario` file.
+ *
+ * @param s Cursor into the line, moved past the token.
+ * @return char* The token, NUL-terminated, or NULL at the end of the line.
+ */
+char	*next_token(char **s)
+{
+	char	*tok;
+
+	while (**s == ' ' || **s == '\t' || **s == '\r')
+		(*s)++;
+	if (**s == '\0')
+		return (NULL);
+	tok = *s;
+	while (**s && **s != ' ' && **s != '\t' && **s != '\r')
+		(*s)++;
+	if (**s)
+	{
+		**s = '\0';
+		(*s)++;
+	}
+	return (tok);
+}
+
+/**
+ * @brief Counts the lines of `s`, an upper bound on its runs or rules.
+ *
+ * @param s The NUL-terminated text.
+ * @return int The number of lines, at least 1.
+ */
+int	count_lines(const char *s)
+{
+	int	lines;
+
+	lines = 1;
+	while (*s)
+	{
+		if (*s == '\n')
+			lines++;
+		s++;
+	}
+	return (lines);
+}
+
+/**
+ * @brief Cuts the line at `*s` and moves `*s` to the next one.
+ *
+ * A `#` comment is cut off the line as well. Also used to read the
+ * `--scenario` file.
+ *
+ * @param s Cursor into the text.
+ * @return char* The line, NUL-terminated.
+ */
+char	*next_line(char **s)
+{
+	char	*line;
+	char	*comment;
+
+	line = *s;
+	comment = NULL;
+	while (**s && **s != '\n')
+	{
+		if (**s == '#' && !comment)
+			comment = *s;
+		(*s)++;
+	}
+	if (**s)
+	{
+		**s = '\0';
+		(*s)++;
+	}
+	if (comment)
+		*comment = '\0';
+	return (line);
+}
+
+/**
+ * @brief Splits one line into the arguments of a run and validates them.
+ *
+ * A blank line gets `ac` 1 and is not a run.
+ *
+ * @param r The run to fill.
+ * @param s The line, split in place.
+ */
+static void	split_line(t_batch_run *r, char *s)
+{
+	char	*tok;
+
+	r->av[0] = "philo";
+	r->ac = 1;
+	r->valid = true;
+	tok = next_token(&s);
+	while (tok)
+	{
+		if (r->ac == BATCH_MAX_ARGS)
+			r->valid = false;
+		else
+		{
+			r->av[r->ac] = tok;
+			r->ac++;
+		}
+		tok = next_token(&s);
+	}
+	r->valid = r->valid && validate_args(r->ac, r->av);
+}
+
+/**
+ * @brief Reads the `--batch` file into its runs.
+ *
+ * `max_philo` is the largest philosopher count of a valid run, or 1.
+ *
+ * @param b The batch, whose `opts.batch` names the file.
+ * @return int Returns EXIT_SUCCESS if the file was read, otherwise
+ * EXIT_FAILURE.
+ */
+int	load_batch(t_batch *b)
+{
+	char	*s;
+
+	b->text = read_file(b->opts.batch);
+	b->runs = NULL;
+	if (b->text)
+		b->runs = malloc(count_lines(b->text) * sizeof(t_batch_run));
+	if (!b->runs)
+	{
+		free(b->text);
+		print_error("Error: load_batch: cannot read the batch file\n");
+		return (EXIT_FAILURE);
+	}
+	b->count = 0;
+	b->max_philo = 1;
+	s = b->text;
+	while (*s)
+	{
+		split_line(&b->runs[b->count], next_line(&s));
+		if (b->runs[b->count].valid
+			&& ft_atoi(b->runs[b->count].av[1]) > b->max_philo)
+			b->max_philo = ft_atoi(b->runs[b->count].av[1]);
+		if (b->runs[b->count].ac > 1)
+			b->count++;
+	}
+	return (EXIT_SUCCESS);
+}
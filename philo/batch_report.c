@@ -0,0 +1,76 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   batch_report.c                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: imunaev- <imunaev-@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 15:04:41 by imunaev-          #+#    #+#             */
+/*   Updated: 2026/10/19 15:04:41 by imunaev-         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file batch_report.c
+ * @brief The summary line `--batch` prints for each configuration.
+ */
+
+#include "philo.h"
+
+/**
+ * @brief Counts the meals eaten by all philosophers of a run.
+ *
+ * @param env Pointer to the environment structure, after the join.
+ * @return long The total number of meals.
+ */
+static long	total_meals(t_env *env)
+{
+	long	meals;
+	int		i;
+
+	meals = 0;
+	i = 0;
+	while (i < env->cfg.num_philo)
+	{
+		meals += env->meals[i];
+		i++;
+	}
+	return (meals);
+}
+
+/**
+ * @brief Prints the summary line of run `i`.
+ *
+ * The line starts with the run number, counted from 1 in file order, and
+ * the configuration, followed by who died when or when the run ended, and
+ * the meals eaten. Each line is a single `printf()`, so the lines of
+ * concurrent runs do not interleave.
+ *
+ * @param b The batch.
+ * @param i Index of the run.
+ * @param env The finished run, or NULL if it was invalid or failed.
+ */
+void	batch_summary(t_batch *b, int i, t_env *env)
+{
+	char	line[BATCH_LINE];
+	int		len;
+	int		k;
+
+	len = snprintf(line, BATCH_LINE, "%d:", i + 1);
+	k = 1;
+	while (k < b->runs[i].ac && len < BATCH_LINE)
+	{
+		len += snprintf(line + len, BATCH_LINE - len, " %s", b->runs[i].av[k]);
+		k++;
+	}
+	if (!b->runs[i].valid)
+		printf("%s: invalid configuration\n", line);
+	else if (!env)
+		printf("%s: failed\n", line);
+	else if (env->dead)
+		printf("%s: %d died at %ld ms, %ld meals\n", line, env->dead,
+			env->dead_at, total_meals(env));
+	else
+		printf("%s: done at %ld ms, %ld meals\n", line,
+			get_time() - env->start_time, total_meals(env));
+}
@@ -0,0 +1,126 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   bench.c                                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: imunaev- <imunaev-@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/03/26 16:02:19 by imunaev-          #+#    #+#             */
+/*   Updated: 2025/03/26 16:02:19 by imunaev-         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file bench.c
+ * @brief Benchmark driver sweeping the simulation's parameters.
+ *
+ * Runs `philo` once per configuration of the sweep: philosopher count,
+ * die/eat/sleep ratio, and fork representation with execution engine.
+ * Every run eats `BENCH_MEALS` meals per philosopher and is measured from
+ * outside (see `bench_run()`). Results go to `<prefix>.csv` and
+ * `<prefix>.json`, and a summary line per run to standard output.
+ *
+ * Usage: `./philo_bench [philo binary] [output prefix]`
+ * (defaults: `./philo` and `bench_results`).
+ */
+
+#include "bench.h"
+
+/**
+ * @brief Fills configuration `k` of the sweep.
+ *
+ * The timing sets are: everyone survives with slack, everyone survives at
+ * the limit (odd counts), and a philosopher starves.
+ *
+ * @param cfg Receives the configuration.
+ * @param k Index of the configuration.
+ * @return int 1 if `k` is a configuration of the sweep, otherwise 0.
+ */
+static int	fill_cfg(t_bench_cfg *cfg, int k)
+{
+	static const int		counts[] = {5, 50, 200, 1000};
+	static const int		times[][3] = {{800, 200, 200}, {410, 200, 200},
+	{310, 200, 100}};
+	static const char *const	modes[][2] = {{"mutex", "thread"},
+	{"bitmap", "thread"}, {"bitmap", "pool"}, {"bitmap", "coro"}};
+
+	if (k >= 4 * 3 * 4)
+		return (0);
+	cfg->num_philo = counts[k / 12];
+	cfg->die_time = times[k / 4 % 3][0];
+	cfg->eat_time = times[k / 4 % 3][1];
+	cfg->sleep_time = times[k / 4 % 3][2];
+	cfg->forks = modes[k % 4][0];
+	cfg->engine = modes[k % 4][1];
+	return (1);
+}
+
+/**
+ * @brief Runs the whole sweep and writes every result.
+ *
+ * @param philo Path of the simulation binary.
+ * @param csv The CSV file.
+ * @param json The JSON file.
+ * @return int Returns EXIT_SUCCESS if every run could be started,
+ * otherwise EXIT_FAILURE.
+ */
+static int	run_sweep(const char *philo, FILE *csv, FILE *json)
+{
+	t_bench_cfg	cfg;
+	t_bench_res	res;
+	int			k;
+
+	bench_csv_header(csv);
+	fprintf(json, "[\n");
+	k = 0;
+	while (fill_cfg(&cfg, k))
+	{
+		if (bench_run(philo, &cfg, BENCH_MEALS, &res) == EXIT_FAILURE)
+			return (EXIT_FAILURE);
+		bench_csv_row(csv, &cfg, &res);
+		bench_json_row(json, &cfg, &res, k == 0);
+		printf("%5d %d/%d/%d %-6s %-6s %10.0f meals/s %8ld us latency\n",
+			cfg.num_philo, cfg.die_time, cfg.eat_time, cfg.sleep_time,
+			cfg.forks, cfg.engine, res.meals * 1e6 / (res.wall_us + 1),
+			res.death_latency_us);
+		k++;
+	}
+	fprintf(json, "\n]\n");
+	return (EXIT_SUCCESS);
+}
+
+/**
+ * @brief Opens the output files and runs the sweep.
+ *
+ * @param ac Argument count.
+ * @param av Argument vector.
+ * @return int Returns EXIT_SUCCESS on success, otherwise EXIT_FAILURE.
+ */
+int	main(int ac, char **av)
+{
+	char		path[2][256];
+	const char	*prefix;
+	FILE		*csv;
+	FILE		*json;
+	int			status;
+
+	prefix = "bench_results";
+	if (ac > 2)
+		prefix = av[2];
+	snprintf(path[0], sizeof(path[0]), "%s.csv", prefix);
+	snprintf(path[1], sizeof(path[1]), "%s.json", prefix);
+	csv = fopen(path[0], "w");
+	json = fopen(path[1], "w");
+	status = EXIT_FAILURE;
+	if (csv && json && ac > 1)
+		status = run_sweep(av[1], csv, json);
+	else if (csv && json)
+		status = run_sweep("./philo", csv, json);
+	if (csv && json)
+		printf("results: %s, %s\n", path[0], path[1]);
+	if (csv)
+		fclose(csv);
+	if (json)
+		fclose(json);
+	return (status);
+}
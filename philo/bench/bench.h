@@ -0,0 +1,90 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   bench.h                                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: imunaev- <imunaev-@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/03/26 14:21:08 by imunaev-          #+#    #+#             */
+/*   Updated: 2025/03/26 14:21:08 by imunaev-         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef BENCH_H
+# define BENCH_H
+
+# include <stdio.h>
+# include <stdlib.h>
+# include <string.h>
+# include <unistd.h>
+# include <sys/types.h>
+
+# define BENCH_MEALS 5
+# define BENCH_ERR_SIZE 16384
+
+/**
+ * @struct s_bench_cfg
+ * @brief One configuration of the sweep.
+ *
+ * `forks` and `engine` are passed to `./philo` as `--forks=` and
+ * `--engine=`.
+ */
+typedef struct s_bench_cfg
+{
+	int			num_philo;
+	int			die_time;
+	int			eat_time;
+	int			sleep_time;
+	const char	*forks;
+	const char	*engine;
+}	t_bench_cfg;
+
+/**
+ * @struct s_bench_res
+ * @brief Measurements of one run.
+ *
+ * `printed` counts the log lines on standard output, which miss the
+ * lines the logger dropped while its buffer was full. The meal count and
+ * the death detection latency come from the `--report` lines on standard
+ * error and the rest from `wait4()`. `death_latency_us` is -1 when nobody
+ * died.
+ */
+typedef struct s_bench_res
+{
+	int		status;
+	long	wall_us;
+	long	printed;
+	long	meals;
+	long	death_latency_us;
+	long	cpu_us;
+	long	ctx_switches;
+	long	max_rss_kb;
+}	t_bench_res;
+
+/**
+ * @struct s_bench_log
+ * @brief Output of the run being read.
+ *
+ * Standard error is kept whole (up to `BENCH_ERR_SIZE - 1` bytes) for the
+ * report parser.
+ */
+typedef struct s_bench_log
+{
+	char	err[BENCH_ERR_SIZE];
+	size_t	err_len;
+}	t_bench_log;
+
+/* Running */
+long	bench_now_us(void);
+pid_t	bench_spawn(const char *philo, const t_bench_cfg *cfg, int meals,
+			int *fds);
+int		bench_run(const char *philo, const t_bench_cfg *cfg, int meals,
+			t_bench_res *res);
+
+/* Output */
+void	bench_csv_header(FILE *f);
+void	bench_csv_row(FILE *f, const t_bench_cfg *cfg, const t_bench_res *res);
+void	bench_json_row(FILE *f, const t_bench_cfg *cfg, const t_bench_res *res,
+			int first);
+
+#endif
@@ -0,0 +1,91 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   bench_out.c                                        :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: imunaev- <imunaev-@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/03/26 15:37:40 by imunaev-          #+#    #+#             */
+/*   Updated: 2025/03/26 15:37:40 by imunaev-         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file bench_out.c
+ * @brief CSV and JSON output of the benchmark driver.
+ *
+ * Both formats carry the same fields, one record per configuration. Rates
+ * are per second of wall time; times are in milliseconds except the death
+ * detection latency, which is in microseconds (-1 when nobody died).
+ */
+
+#include "bench.h"
+
+/**
+ * @brief Returns `count` per second of `us` microseconds.
+ */
+static double	per_sec(long count, long us)
+{
+	if (us <= 0)
+		return (0);
+	return (count * 1e6 / us);
+}
+
+/**
+ * @brief Writes the CSV header line.
+ *
+ * @param f The CSV file.
+ */
+void	bench_csv_header(FILE *f)
+{
+	fprintf(f, "num_philo,die_time,eat_time,sleep_time,forks,engine,"
+		"status,wall_ms,printed_events,meals,meals_per_s,printed_events_per_s,"
+		"death_latency_us,cpu_ms,ctx_switches,max_rss_kb\n");
+}
+
+/**
+ * @brief Writes one CSV record.
+ *
+ * @param f The CSV file.
+ * @param cfg The configuration.
+ * @param res Its measurements.
+ */
+void	bench_csv_row(FILE *f, const t_bench_cfg *cfg, const t_bench_res *res)
+{
+	fprintf(f, "%d,%d,%d,%d,%s,%s,%d,%.1f,%ld,%ld,%.1f,%.1f,%ld,%.1f,%ld,"
+		"%ld\n", cfg->num_philo, cfg->die_time, cfg->eat_time,
+		cfg->sleep_time, cfg->forks, cfg->engine, res->status,
+		res->wall_us / 1e3, res->printed, res->meals,
+		per_sec(res->meals, res->wall_us), per_sec(res->printed, res->wall_us),
+		res->death_latency_us, res->cpu_us / 1e3, res->ctx_switches,
+		res->max_rss_kb);
+	fflush(f);
+}
+
+/**
+ * @brief Writes one JSON object of the result array.
+ *
+ * @param f The JSON file.
+ * @param cfg The configuration.
+ * @param res Its measurements.
+ * @param first Whether this is the first object of the array.
+ */
+void	bench_json_row(FILE *f, const t_bench_cfg *cfg, const t_bench_res *res,
+		int first)
+{
+	if (!first)
+		fprintf(f, ",\n");
+	fprintf(f, "  {\"num_philo\": %d, \"die_time\": %d, \"eat_time\": %d, "
+		"\"sleep_time\": %d, \"forks\": \"%s\", \"engine\": \"%s\", "
+		"\"status\": %d, \"wall_ms\": %.1f, \"printed_events\": %ld, "
+		"\"meals\": %ld, \"meals_per_s\": %.1f, "
+		"\"printed_events_per_s\": %.1f, "
+		"\"death_latency_us\": %ld, \"cpu_ms\": %.1f, "
+		"\"ctx_switches\": %ld, \"max_rss_kb\": %ld}",
+		cfg->num_philo, cfg->die_time, cfg->eat_time, cfg->sleep_time,
+		cfg->forks, cfg->engine, res->status, res->wall_us / 1e3,
+		res->printed, res->meals, per_sec(res->meals, res->wall_us),
+		per_sec(res->printed, res->wall_us), res->death_latency_us,
+		res->cpu_us / 1e3, res->ctx_switches, res->max_rss_kb);
+	fflush(f);
+}
@@ -0,0 +1,173 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   bench_run.c                                        :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: imunaev- <imunaev-@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/03/26 15:05:12 by imunaev-          #+#    #+#             */
+/*   Updated: 2025/03/26 15:05:12 by imunaev-         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file bench_run.c
+ * @brief Runs one configuration and collects its measurements.
+ */
+
+#include "bench.h"
+#include <poll.h>
+#include <sys/resource.h>
+#include <sys/time.h>
+#include <sys/wait.h>
+
+/**
+ * @brief Counts the log lines in a chunk of standard output.
+ *
+ * Every line is one printed event. The logger drops lines while its
+ * buffer is full, so for large runs this is fewer than the events that
+ * happened; meals are therefore taken from `--report` instead (see
+ * `fill_usage()`).
+ *
+ * @param buf The chunk.
+ * @param n Size of the chunk.
+ * @param res Receives the counts.
+ */
+static void	scan_log(const char *buf, ssize_t n, t_bench_res *res)
+{
+	ssize_t	i;
+
+	i = 0;
+	while (i < n)
+	{
+		if (buf[i] == '\n')
+			res->printed++;
+		i++;
+	}
+}
+
+/**
+ * @brief Reads what is available on one of the pipes.
+ *
+ * @param pfd The pipe; its descriptor is set to -1 once it is closed.
+ * @param is_err Whether this is the standard error pipe.
+ * @param log Reader state.
+ * @param res Receives the counts.
+ * @return int 1 if the pipe is still open, otherwise 0.
+ */
+static int	read_ready(struct pollfd *pfd, int is_err, t_bench_log *log,
+		t_bench_res *res)
+{
+	char	buf[65536];
+	ssize_t	n;
+
+	if (pfd->fd < 0 || !pfd->revents)
+		return (pfd->fd >= 0);
+	n = read(pfd->fd, buf, sizeof(buf));
+	if (n <= 0)
+	{
+		pfd->fd = -1;
+		return (0);
+	}
+	if (!is_err)
+		scan_log(buf, n, res);
+	else if (log->err_len + n < BENCH_ERR_SIZE)
+	{
+		memcpy(log->err + log->err_len, buf, n);
+		log->err_len += n;
+		log->err[log->err_len] = '\0';
+	}
+	return (1);
+}
+
+/**
+ * @brief Reads both pipes until the child closes them.
+ *
+ * @param fds Read ends of the standard output and standard error pipes.
+ * @param log Reader state.
+ * @param res Receives the counts.
+ */
+static void	drain(int *fds, t_bench_log *log, t_bench_res *res)
+{
+	struct pollfd	pfd[2];
+	int				open;
+
+	pfd[0].fd = fds[0];
+	pfd[1].fd = fds[1];
+	pfd[0].events = POLLIN;
+	pfd[1].events = POLLIN;
+	open = 2;
+	while (open > 0 && poll(pfd, 2, -1) >= 0)
+		open = read_ready(&pfd[0], 0, log, res)
+			+ read_ready(&pfd[1], 1, log, res);
+}
+
+/**
+ * @brief Fills the measurements taken from the reaped child.
+ *
+ * The meal count and the death detection latency come from the
+ * `throughput:` and `death detected` lines of `--report`; meals stay 0
+ * if the run printed no report.
+ *
+ * @param res Receives the measurements.
+ * @param ru Resource usage of the child.
+ * @param wstatus Wait status of the child.
+ * @param err Standard error of the child.
+ */
+static void	fill_usage(t_bench_res *res, const struct rusage *ru, int wstatus,
+		const char *err)
+{
+	res->status = -1;
+	if (WIFEXITED(wstatus))
+		res->status = WEXITSTATUS(wstatus);
+	res->cpu_us = ru->ru_utime.tv_sec * 1000000L + ru->ru_utime.tv_usec
+		+ ru->ru_stime.tv_sec * 1000000L + ru->ru_stime.tv_usec;
+	res->ctx_switches = ru->ru_nvcsw + ru->ru_nivcsw;
+	res->max_rss_kb = ru->ru_maxrss;
+	res->death_latency_us = -1;
+	if (strstr(err, "throughput: "))
+		res->meals = atol(strstr(err, "throughput: ") + strlen("throughput: "));
+	err = strstr(err, "death detected ");
+	if (err)
+		res->death_latency_us = atol(err + strlen("death detected "));
+}
+
+/**
+ * @brief Runs `philo` with one configuration and measures it.
+ *
+ * CPU time, context switches and peak RSS come from `wait4()` and cover
+ * the whole simulation process. `status` is the exit code, or -1 if the
+ * process was killed by a signal.
+ *
+ * @param philo Path of the simulation binary.
+ * @param cfg The configuration.
+ * @param meals Number of meals each philosopher eats.
+ * @param res Receives the measurements.
+ * @return int Returns EXIT_SUCCESS if the run could be started and waited
+ * for, otherwise EXIT_FAILURE.
+ */
+int	bench_run(const char *philo, const t_bench_cfg *cfg, int meals,
+		t_bench_res *res)
+{
+	static t_bench_log	log;
+	struct rusage		ru;
+	int					fds[2];
+	int					wstatus;
+	pid_t				pid;
+
+	memset(res, 0, sizeof(*res));
+	memset(&log, 0, sizeof(log));
+	fds[0] = -1;
+	fds[1] = -1;
+	res->wall_us = bench_now_us();
+	pid = bench_spawn(philo, cfg, meals, fds);
+	if (pid > 0)
+		drain(fds, &log, res);
+	close(fds[0]);
+	close(fds[1]);
+	if (pid < 0 || wait4(pid, &wstatus, 0, &ru) < 0)
+		return (EXIT_FAILURE);
+	res->wall_us = bench_now_us() - res->wall_us;
+	fill_usage(res, &ru, wstatus, log.err);
+	return (EXIT_SUCCESS);
+}
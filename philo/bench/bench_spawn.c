@@ -0,0 +1,126 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   bench_spawn.c                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: imunaev- <imunaev-@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/03/26 14:40:33 by imunaev-          #+#    #+#             */
+/*   Updated: 2025/03/26 14:40:33 by imunaev-         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file bench_spawn.c
+ * @brief Starts one simulation run for the benchmark driver.
+ */
+
+#include "bench.h"
+#include <time.h>
+
+/**
+ * @brief Returns a monotonic timestamp in microseconds.
+ */
+long	bench_now_us(void)
+{
+	struct timespec	ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (ts.tv_sec * 1000000L + ts.tv_nsec / 1000);
+}
+
+/**
+ * @brief Builds the argument vector of one run.
+ *
+ * The run always gets `--report`, so that the death detection latency is
+ * printed on standard error.
+ *
+ * @param arg Storage for the formatted arguments.
+ * @param argv Argument vector to fill, NULL-terminated.
+ * @param cfg The configuration.
+ * @param meals Number of meals each philosopher eats.
+ */
+static void	build_argv(char arg[7][32], char **argv, const t_bench_cfg *cfg,
+		int meals)
+{
+	int	i;
+
+	snprintf(arg[0], 32, "--forks=%s", cfg->forks);
+	snprintf(arg[1], 32, "--engine=%s", cfg->engine);
+	snprintf(arg[2], 32, "%d", cfg->num_philo);
+	snprintf(arg[3], 32, "%d", cfg->die_time);
+	snprintf(arg[4], 32, "%d", cfg->eat_time);
+	snprintf(arg[5], 32, "%d", cfg->sleep_time);
+	snprintf(arg[6], 32, "%d", meals);
+	argv[1] = arg[0];
+	argv[2] = arg[1];
+	argv[3] = "--report";
+	i = 2;
+	while (i < 7)
+	{
+		argv[i + 2] = arg[i];
+		i++;
+	}
+	argv[9] = NULL;
+}
+
+/**
+ * @brief Runs the child side: redirects the output and executes `philo`.
+ *
+ * @param philo Path of the simulation binary.
+ * @param argv Argument vector.
+ * @param out Pipe receiving standard output.
+ * @param err Pipe receiving standard error.
+ */
+static void	exec_child(const char *philo, char **argv, int *out, int *err)
+{
+	if (dup2(out[1], STDOUT_FILENO) < 0 || dup2(err[1], STDERR_FILENO) < 0)
+		_exit(127);
+	close(out[0]);
+	close(out[1]);
+	close(err[0]);
+	close(err[1]);
+	argv[0] = (char *)philo;
+	execv(philo, argv);
+	_exit(127);
+}
+
+/**
+ * @brief Starts `philo` with one configuration.
+ *
+ * Once the pipes exist, `fds` holds their read ends even if `fork()`
+ * fails, and the caller closes them.
+ *
+ * @param philo Path of the simulation binary.
+ * @param cfg The configuration.
+ * @param meals Number of meals each philosopher eats.
+ * @param fds Receives the read ends: `fds[0]` stdout, `fds[1]` stderr.
+ * @return pid_t The child process, or -1 on failure.
+ */
+pid_t	bench_spawn(const char *philo, const t_bench_cfg *cfg, int meals,
+		int *fds)
+{
+	char	arg[7][32];
+	char	*argv[10];
+	int		out[2];
+	int		err[2];
+	pid_t	pid;
+
+	build_argv(arg, argv, cfg, meals);
+	if (pipe(out) < 0)
+		return (-1);
+	if (pipe(err) < 0)
+	{
+		close(out[0]);
+		close(out[1]);
+		return (-1);
+	}
+	pid = fork();
+	if (pid == 0)
+		exec_child(philo, argv, out, err);
+	close(out[1]);
+	close(err[1]);
+	fds[0] = out[0];
+	fds[1] = err[0];
+	return (pid);
+}
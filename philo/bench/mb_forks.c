@@ -0,0 +1,96 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   mb_forks.c                                         :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: imunaev- <imunaev-@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/03/27 11:40:17 by imunaev-          #+#    #+#             */
+/*   Updated: 2025/03/27 11:40:17 by imunaev-         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file mb_forks.c
+ * @brief Microbenchmarks of `take_forks()` and `put_forks()`.
+ */
+
+#include "microbench.h"
+
+/**
+ * @brief Times batches of take/put pairs for one philosopher.
+ *
+ * The log buffer is emptied before every batch so that the pairs never hit
+ * the full-buffer path; nothing flushes it while this runs.
+ *
+ * @param p Pointer to the philosopher.
+ * @param v Room for `MB_SAMPLES` results, in ns per pair.
+ */
+static void	fork_loop(t_philo *p, long *v)
+{
+	long	start;
+	int		i;
+	int		k;
+
+	i = 0;
+	while (i < MB_WARMUP + MB_SAMPLES)
+	{
+		pthread_mutex_lock(&p->env->log_buffer.mutex);
+		p->env->log_buffer.count = 0;
+		pthread_mutex_unlock(&p->env->log_buffer.mutex);
+		start = mb_now_ns();
+		k = 0;
+		while (k < MB_BATCH)
+		{
+			take_forks(p);
+			put_forks(p);
+			k++;
+		}
+		if (i >= MB_WARMUP)
+			v[i - MB_WARMUP] = (mb_now_ns() - start) / MB_BATCH;
+		i++;
+	}
+}
+
+/**
+ * @brief Thread running `fork_loop()` for a worker.
+ *
+ * @param arg Pointer to the worker (`t_mb_worker`).
+ * @return NULL when the samples are taken.
+ */
+static void	*contender(void *arg)
+{
+	t_mb_worker	*w;
+
+	w = (t_mb_worker *)arg;
+	fork_loop(w->p, w->v);
+	return (NULL);
+}
+
+/**
+ * @brief Measures a take/put pair uncontended, then with philosophers 0
+ * and 1 fighting over their shared fork.
+ *
+ * @param env Pointer to the environment structure.
+ * @param mode Fork mode name used in the report.
+ */
+void	mb_forks(t_env *env, const char *mode)
+{
+	static long	v[2 * MB_SAMPLES];
+	t_mb_worker	w[2];
+	char		name[48];
+
+	fork_loop(&env->philos[0], v);
+	snprintf(name, sizeof(name), "take+put_forks %s", mode);
+	mb_report(name, "ns/pair", v, MB_SAMPLES);
+	w[0].p = &env->philos[0];
+	w[0].v = v;
+	w[1].p = &env->philos[1];
+	w[1].v = v + MB_SAMPLES;
+	if (pthread_create(&w[1].thread, NULL, contender, &w[1]) != 0)
+		return ;
+	fork_loop(w[0].p, w[0].v);
+	pthread_join(w[1].thread, NULL);
+	snprintf(name, sizeof(name), "take+put_forks %s x2", mode);
+	mb_report(name, "ns/pair", v, 2 * MB_SAMPLES);
+}
@@ -0,0 +1,178 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   mb_log.c                                           :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: imunaev- <imunaev-@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/03/27 11:05:52 by imunaev-          #+#    #+#             */
+/*   Updated: 2025/03/27 11:05:52 by imunaev-         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file mb_log.c
+ * @brief Microbenchmarks of the logging primitives.
+ *
+ * The log is written to `/dev/null` while these run, so that the terminal
+ * does not slow the flusher down.
+ */
+
+#include "microbench.h"
+
+/**
+ * @brief Producer thread calling `buffered_print()` in batches.
+ *
+ * The buffer is emptied before each timed batch, as in `fork_loop()`, so
+ * that the samples measure appends and not the drop path of a full
+ * buffer: the flusher only runs every millisecond, and even with every
+ * producer in the middle of a batch the buffer holds at most
+ * `MB_MAX_PRODUCERS * MB_BATCH` entries, which is below
+ * `LOG_BUFFER_SIZE`.
+ *
+ * @param arg Pointer to the worker (`t_mb_worker`).
+ * @return NULL when the samples are taken.
+ */
+static void	*producer(void *arg)
+{
+	t_mb_worker	*w;
+	long		start;
+	int			i;
+	int			k;
+
+	w = (t_mb_worker *)arg;
+	i = 0;
+	while (i < MB_WARMUP + MB_SAMPLES)
+	{
+		pthread_mutex_lock(&w->env->log_buffer.mutex);
+		w->env->log_buffer.count = 0;
+		pthread_mutex_unlock(&w->env->log_buffer.mutex);
+		start = mb_now_ns();
+		k = 0;
+		while (k < MB_BATCH)
+		{
+			buffered_print(w->env, i, k, "is thinking");
+			k++;
+		}
+		if (i >= MB_WARMUP)
+			w->v[i - MB_WARMUP] = (mb_now_ns() - start) / MB_BATCH;
+		i++;
+	}
+	return (NULL);
+}
+
+/**
+ * @brief Joins the producers, then ends the run so that `log_flusher()`
+ * drains the buffer and exits.
+ *
+ * @param env Pointer to the environment structure.
+ * @param flusher The flusher thread.
+ * @param w The producers.
+ * @param n Number of producers started.
+ */
+static void	stop_run(t_env *env, pthread_t flusher, t_mb_worker *w, int n)
+{
+	int	i;
+
+	i = 0;
+	while (i < n)
+	{
+		pthread_join(w[i].thread, NULL);
+		i++;
+	}
+	pthread_mutex_lock(&env->end_mutex);
+	env->ended = true;
+	pthread_mutex_unlock(&env->end_mutex);
+	pthread_join(flusher, NULL);
+}
+
+/**
+ * @brief Runs `n` producers against the real `log_flusher()` thread and
+ * reports the cost of one `buffered_print()` call.
+ *
+ * @param env Pointer to the environment structure.
+ * @param w At least `n` workers, whose samples are contiguous.
+ * @param n Number of producers.
+ */
+static void	bench_producers(t_env *env, t_mb_worker *w, int n)
+{
+	pthread_t	flusher;
+	char		name[32];
+	int			saved;
+	int			i;
+
+	saved = mb_mute_stdout();
+	env->ended = false;
+	i = 0;
+	if (pthread_create(&flusher, NULL, log_flusher, env) == 0)
+	{
+		while (i < n && !pthread_create(&w[i].thread, NULL, producer, &w[i]))
+			i++;
+		stop_run(env, flusher, w, i);
+	}
+	mb_restore_stdout(saved);
+	snprintf(name, sizeof(name), "buffered_print x%d", i);
+	if (i > 0)
+		mb_report(name, "ns/call", w[0].v, i * MB_SAMPLES);
+}
+
+/**
+ * @brief Measures `flush_log_entries()` on a full buffer.
+ *
+ * @param env Pointer to the environment structure.
+ */
+static void	bench_flush(t_env *env)
+{
+	long	v[MB_SAMPLES];
+	long	start;
+	int		saved;
+	int		i;
+	int		k;
+
+	saved = mb_mute_stdout();
+	i = 0;
+	while (i < MB_WARMUP + MB_SAMPLES)
+	{
+		k = 0;
+		while (k < LOG_BUFFER_SIZE)
+		{
+			buffered_print(env, i, k, "is eating");
+			k++;
+		}
+		start = mb_now_ns();
+		flush_log_entries(env, env->log_buffer.count);
+		if (i >= MB_WARMUP)
+			v[i - MB_WARMUP] = (mb_now_ns() - start) / LOG_BUFFER_SIZE;
+		i++;
+	}
+	mb_restore_stdout(saved);
+	mb_report("flush_log_entries", "ns/entry", v, MB_SAMPLES);
+}
+
+/**
+ * @brief Measures `buffered_print()` under 1 to `MB_MAX_PRODUCERS`
+ * producers, then `flush_log_entries()`.
+ *
+ * @param env Pointer to the environment structure.
+ */
+void	mb_log(t_env *env)
+{
+	static long	v[MB_MAX_PRODUCERS * MB_SAMPLES];
+	t_mb_worker	w[MB_MAX_PRODUCERS];
+	int			n;
+
+	n = 0;
+	while (n < MB_MAX_PRODUCERS)
+	{
+		w[n].env = env;
+		w[n].v = v + n * MB_SAMPLES;
+		n++;
+	}
+	n = 1;
+	while (n <= MB_MAX_PRODUCERS)
+	{
+		bench_producers(env, w, n);
+		n *= 2;
+	}
+	bench_flush(env);
+}
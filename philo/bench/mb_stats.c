@@ -0,0 +1,97 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   mb_stats.c                                         :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: imunaev- <imunaev-@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/03/27 10:20:03 by imunaev-          #+#    #+#             */
+/*   Updated: 2025/03/27 10:20:03 by imunaev-         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file mb_stats.c
+ * @brief Timing and percentile reporting of the microbenchmarks.
+ */
+
+#include "microbench.h"
+#include <fcntl.h>
+#include <time.h>
+
+/**
+ * @brief Returns a monotonic timestamp in nanoseconds.
+ */
+long	mb_now_ns(void)
+{
+	struct timespec	ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (ts.tv_sec * 1000000000L + ts.tv_nsec);
+}
+
+/**
+ * @brief Orders two samples for `qsort()`.
+ */
+static int	cmp_long(const void *a, const void *b)
+{
+	if (*(const long *)a < *(const long *)b)
+		return (-1);
+	return (*(const long *)a > *(const long *)b);
+}
+
+/**
+ * @brief Sorts the samples and prints their minimum, percentiles and
+ * maximum on one line.
+ *
+ * @param name Name of the measured primitive.
+ * @param unit Unit of the samples.
+ * @param v The samples; sorted in place.
+ * @param n Number of samples.
+ */
+void	mb_report(const char *name, const char *unit, long *v, int n)
+{
+	qsort(v, n, sizeof(long), cmp_long);
+	printf("%-24s %-10s %8ld %8ld %8ld %8ld %8ld\n", name, unit, v[0],
+		v[n / 2], v[n * 9 / 10], v[n * 99 / 100], v[n - 1]);
+	fflush(stdout);
+}
+
+/**
+ * @brief Sends standard output to `/dev/null` while the log primitives
+ * print.
+ *
+ * @return int The saved standard output, or -1 if it was not redirected.
+ */
+int	mb_mute_stdout(void)
+{
+	int	saved;
+	int	null;
+
+	fflush(stdout);
+	saved = dup(STDOUT_FILENO);
+	null = open("/dev/null", O_WRONLY);
+	if (saved < 0 || null < 0 || dup2(null, STDOUT_FILENO) < 0)
+	{
+		if (saved >= 0)
+			close(saved);
+		saved = -1;
+	}
+	if (null >= 0)
+		close(null);
+	return (saved);
+}
+
+/**
+ * @brief Restores the standard output saved by `mb_mute_stdout()`.
+ *
+ * @param saved The saved standard output.
+ */
+void	mb_restore_stdout(int saved)
+{
+	fflush(stdout);
+	if (saved < 0)
+		return ;
+	dup2(saved, STDOUT_FILENO);
+	close(saved);
+}
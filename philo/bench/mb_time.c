@@ -0,0 +1,101 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   mb_time.c                                          :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: imunaev- <imunaev-@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/03/27 10:41:17 by imunaev-          #+#    #+#             */
+/*   Updated: 2025/03/27 10:41:17 by imunaev-         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file mb_time.c
+ * @brief Microbenchmarks of the clock and sleep primitives.
+ */
+
+#include "microbench.h"
+
+/**
+ * @brief Measures the cost of one clock read.
+ *
+ * Each sample times a batch of `MB_BATCH` calls.
+ *
+ * @param name Name of the clock.
+ * @param clock The clock function.
+ */
+static void	bench_clock(const char *name, long (*clock)(void))
+{
+	long			v[MB_SAMPLES];
+	volatile long	sink;
+	long			start;
+	int				i;
+	int				k;
+
+	i = 0;
+	while (i < MB_WARMUP + MB_SAMPLES)
+	{
+		start = mb_now_ns();
+		k = 0;
+		while (k < MB_BATCH)
+		{
+			sink = clock();
+			k++;
+		}
+		if (i >= MB_WARMUP)
+			v[i - MB_WARMUP] = (mb_now_ns() - start) / MB_BATCH;
+		i++;
+	}
+	(void)sink;
+	mb_report(name, "ns/call", v, MB_SAMPLES);
+}
+
+/**
+ * @brief Measures the cost of `get_time()` and `get_time_us()`.
+ */
+void	mb_clocks(void)
+{
+	bench_clock("get_time", get_time);
+	bench_clock("get_time_us", get_time_us);
+}
+
+/**
+ * @brief Measures how late `precise_sleep()` returns.
+ *
+ * The error is the time slept minus the requested time; it can be
+ * negative because `precise_sleep()` counts whole milliseconds.
+ *
+ * @param ms Requested sleep in milliseconds.
+ * @param samples Number of samples to take after the warmup.
+ */
+static void	bench_sleep(long ms, int samples)
+{
+	long	v[MB_SAMPLES];
+	long	start;
+	char	name[32];
+	int		i;
+
+	i = 0;
+	while (i < 3 + samples)
+	{
+		start = mb_now_ns();
+		precise_sleep(ms);
+		if (i >= 3)
+			v[i - 3] = (mb_now_ns() - start) / 1000 - ms * 1000;
+		i++;
+	}
+	snprintf(name, sizeof(name), "precise_sleep(%ld)", ms);
+	mb_report(name, "us late", v, samples);
+}
+
+/**
+ * @brief Measures the accuracy of `precise_sleep()` for short and
+ * typical durations.
+ */
+void	mb_sleep(void)
+{
+	bench_sleep(1, 100);
+	bench_sleep(10, 30);
+	bench_sleep(100, 10);
+}
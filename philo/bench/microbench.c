@@ -0,0 +1,60 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   microbench.c                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: imunaev- <imunaev-@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/03/27 11:58:40 by imunaev-          #+#    #+#             */
+/*   Updated: 2025/03/27 11:58:40 by imunaev-         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file microbench.c
+ * @brief Entry point of the `microbench` binary.
+ *
+ * Times the primitives on the simulation hot path one by one, linked
+ * against the same objects as `philo`. Every line reports the spread of
+ * `MB_SAMPLES` repeated runs taken after `MB_WARMUP` discarded ones.
+ */
+
+#include "microbench.h"
+
+/**
+ * @brief Builds a five-philosopher environment with the given fork mode.
+ *
+ * @param mode Fork implementation to use.
+ * @return t_env* The environment; `init_program()` exits on failure.
+ */
+static t_env	*make_env(t_fork_mode mode)
+{
+	static char	*av[] = {"microbench", "5", "800", "200", "200", NULL};
+	t_opts		opts;
+	t_env		*env;
+
+	init_opts(&opts);
+	opts.fork_mode = mode;
+	init_program(&env, &opts, 5, av);
+	env->start_time = get_time();
+	return (env);
+}
+
+int	main(void)
+{
+	t_env	*mutex_env;
+	t_env	*bitmap_env;
+
+	mutex_env = make_env(FORK_MUTEX);
+	bitmap_env = make_env(FORK_BITMAP);
+	printf("%-24s %-10s %8s %8s %8s %8s %8s\n", "primitive", "unit",
+		"min", "p50", "p90", "p99", "max");
+	mb_clocks();
+	mb_sleep();
+	mb_log(mutex_env);
+	mb_forks(mutex_env, "mutex");
+	mb_forks(bitmap_env, "bitmap");
+	free_all(mutex_env);
+	free_all(bitmap_env);
+	return (EXIT_SUCCESS);
+}
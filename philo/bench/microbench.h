@@ -0,0 +1,51 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   microbench.h                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: imunaev- <imunaev-@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/03/27 10:11:45 by imunaev-          #+#    #+#             */
+/*   Updated: 2025/03/27 10:11:45 by imunaev-         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef MICROBENCH_H
+# define MICROBENCH_H
+
+# include "../philo.h"
+
+# define MB_WARMUP 20
+# define MB_SAMPLES 200
+# define MB_BATCH 64
+# define MB_MAX_PRODUCERS 8
+
+/**
+ * @struct s_mb_worker
+ * @brief One thread of a multi-threaded microbenchmark.
+ *
+ * Each worker records `MB_SAMPLES` samples into its own slice of `v`. The
+ * slices of the workers of one run are contiguous, so that their
+ * percentiles are taken over all of them at once.
+ */
+typedef struct s_mb_worker
+{
+	t_env		*env;
+	t_philo		*p;
+	pthread_t	thread;
+	long		*v;
+}	t_mb_worker;
+
+/* Statistics */
+long	mb_now_ns(void);
+void	mb_report(const char *name, const char *unit, long *v, int n);
+int		mb_mute_stdout(void);
+void	mb_restore_stdout(int saved);
+
+/* Primitives */
+void	mb_clocks(void);
+void	mb_sleep(void);
+void	mb_log(t_env *env);
+void	mb_forks(t_env *env, const char *mode);
+
+#endif
@@ -0,0 +1,179 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   scan_bench.c                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: imunaev- <imunaev-@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/03/26 11:02:50 by imunaev-          #+#    #+#             */
+/*   Updated: 2025/03/26 11:02:50 by imunaev-         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file scan_bench.c
+ * @brief Microbenchmark of the monitor's scan kernels.
+ *
+ * Times one full scan of a `deadline` array in which nobody is starved,
+ * which is what the polling monitor does every tick, for each kernel the
+ * CPU supports. Results are printed per million philosophers.
+ *
+ * Usage: `./scan_bench [philosophers]` (default 1000000).
+ */
+
+#include "../philo.h"
+#include <time.h>
+
+#define SCAN_WARMUP 3
+#define SCAN_REPS 21
+
+/**
+ * @brief Returns a monotonic timestamp in nanoseconds.
+ */
+static long	now_ns(void)
+{
+	struct timespec	ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (ts.tv_sec * 1000000000L + ts.tv_nsec);
+}
+
+/**
+ * @brief Sorts `n` samples in ascending order.
+ *
+ * @param t The samples.
+ * @param n Number of samples.
+ */
+static void	sort_samples(long *t, int n)
+{
+	long	v;
+	int		i;
+	int		j;
+
+	i = 1;
+	while (i < n)
+	{
+		v = t[i];
+		j = i;
+		while (j > 0 && t[j - 1] > v)
+		{
+			t[j] = t[j - 1];
+			j--;
+		}
+		t[j] = v;
+		i++;
+	}
+}
+
+/**
+ * @brief Checks that every kernel finds the same starved philosopher.
+ *
+ * Each kernel scans a short array from an unaligned start, with the
+ * starved entry at every position and then with none, so that both the
+ * vector loop and the scalar tail are covered.
+ *
+ * @param k The kernels.
+ * @param nk Number of kernels.
+ * @return int Returns EXIT_SUCCESS if all kernels agree, otherwise
+ * EXIT_FAILURE.
+ */
+static int	check_kernels(const t_scan_kernel *k, int nk)
+{
+	long	a[37];
+	int		pos;
+	int		i;
+
+	pos = 1;
+	while (pos <= 37)
+	{
+		i = 0;
+		while (i < 37)
+		{
+			a[i] = 1000 - 500 * (i == pos);
+			i++;
+		}
+		i = 0;
+		while (i < nk && k[i].fn(a, 1, 37, 900) == pos)
+			i++;
+		if (i < nk)
+		{
+			fprintf(stderr, "%s: wrong result\n", k[i].name);
+			return (EXIT_FAILURE);
+		}
+		pos++;
+	}
+	return (EXIT_SUCCESS);
+}
+
+/**
+ * @brief Times `SCAN_REPS` full scans with one kernel and prints the
+ * minimum and median, scaled to one million philosophers.
+ *
+ * The table is refilled first so that every kernel starts from the same
+ * cache state.
+ *
+ * @param k The kernel.
+ * @param a Room for `n` last meal times.
+ * @param n Number of philosophers.
+ */
+static void	bench_kernel(const t_scan_kernel *k, long *a, int n)
+{
+	long	t[SCAN_REPS];
+	long	start;
+	int		i;
+
+	i = 0;
+	while (i < n)
+	{
+		a[i] = 1000 + i % 7;
+		i++;
+	}
+	i = 0;
+	while (i < SCAN_WARMUP + SCAN_REPS)
+	{
+		start = now_ns();
+		if (k->fn(a, 0, n, 0) != n)
+			fprintf(stderr, "%s: false positive\n", k->name);
+		if (i >= SCAN_WARMUP)
+			t[i - SCAN_WARMUP] = now_ns() - start;
+		i++;
+	}
+	sort_samples(t, SCAN_REPS);
+	printf("%-8s min %8.1f us  median %8.1f us  per million philosophers\n",
+		k->name, t[0] * 1e3 / n, t[SCAN_REPS / 2] * 1e3 / n);
+}
+
+/**
+ * @brief Checks the kernels, then benchmarks each of them.
+ *
+ * @param ac Argument count.
+ * @param av Argument vector; `av[1]` is the number of philosophers.
+ * @return int Returns EXIT_SUCCESS, or EXIT_FAILURE if a kernel is wrong.
+ */
+int	main(int ac, char **av)
+{
+	t_scan_kernel	k[3];
+	long			*a;
+	int				nk;
+	int				n;
+	int				i;
+
+	n = 1000000;
+	if (ac > 1)
+		n = atoi(av[1]);
+	nk = scan_kernels(k);
+	if (n < 1 || check_kernels(k, nk) == EXIT_FAILURE)
+		return (EXIT_FAILURE);
+	a = malloc(n * sizeof(long));
+	if (!a)
+		return (EXIT_FAILURE);
+	printf("%d philosophers, selected kernel: %s\n", n, select_scan().name);
+	i = 0;
+	while (i < nk)
+	{
+		bench_kernel(&k[i], a, n);
+		i++;
+	}
+	free(a);
+	return (EXIT_SUCCESS);
+}
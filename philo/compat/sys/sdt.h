@@ -0,0 +1,30 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   sdt.h                                              :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: imunaev- <imunaev-@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/03/29 10:12:40 by imunaev-          #+#    #+#             */
+/*   Updated: 2025/03/29 10:12:40 by imunaev-         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file sdt.h
+ * @brief No-op stand-in for `<sys/sdt.h>` when systemtap-sdt is missing.
+ *
+ * The Makefile adds this directory with `-idirafter`, so it is only found
+ * when the system has no `<sys/sdt.h>`. The probes then compile to
+ * nothing, and their arguments are not evaluated.
+ */
+
+#ifndef _SYS_SDT_H
+# define _SYS_SDT_H
+
+# define DTRACE_PROBE(provider, name)
+# define DTRACE_PROBE1(provider, name, a1)
+# define DTRACE_PROBE2(provider, name, a1, a2)
+# define DTRACE_PROBE3(provider, name, a1, a2, a3)
+
+#endif
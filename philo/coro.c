@@ -0,0 +1,85 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   coro.c                                             :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: imunaev- <imunaev-@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/03/22 09:31:27 by imunaev-          #+#    #+#             */
+/*   Updated: 2025/03/22 09:31:27 by imunaev-         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file coro.c
+ * @brief Blocking points of philosophers run as coroutines.
+ *
+ * `routine()` is shared by the thread and coroutine engines. Wherever a
+ * philosopher thread would block (sleeping, waiting for forks), a
+ * coroutine instead records when it wants to run again and switches back
+ * to its carrier, which runs the other coroutines in the meantime.
+ */
+
+#include "philo.h"
+
+/**
+ * @brief Suspends the coroutine until the absolute time `wake_at`.
+ *
+ * @param p Pointer to the philosopher structure.
+ * @param wake_at Absolute wake-up time in microseconds.
+ */
+static void	coro_yield(t_philo *p, long wake_at)
+{
+	p->coro->wake_at = wake_at;
+	coro_switch(&p->coro->ctx, &p->coro->carrier->sched);
+}
+
+/**
+ * @brief Entry point of a philosopher coroutine.
+ *
+ * Once `routine()` returns, the coroutine is marked done and switches
+ * back to its carrier for the last time; the carrier never resumes it.
+ *
+ * @param p Pointer to the philosopher structure.
+ */
+void	coro_entry(t_philo *p)
+{
+	(void)routine(p);
+	p->coro->done = true;
+	coro_switch(&p->coro->ctx, &p->coro->carrier->sched);
+}
+
+/**
+ * @brief Sleeps for `ms` milliseconds in either engine.
+ *
+ * A philosopher thread uses `precise_sleep()`; a coroutine yields to its
+ * carrier until the time has passed.
+ *
+ * @param p Pointer to the philosopher structure.
+ * @param ms The duration to sleep in milliseconds.
+ */
+void	philo_sleep(t_philo *p, long ms)
+{
+	if (!p->coro)
+	{
+		precise_sleep(ms);
+		return ;
+	}
+	coro_yield(p, get_time_us() + ms * 1000);
+}
+
+/**
+ * @brief Pauses for `us` microseconds in either engine.
+ *
+ * @param p Pointer to the philosopher structure.
+ * @param us The duration to pause in microseconds.
+ */
+void	philo_wait_us(t_philo *p, long us)
+{
+	if (!p->coro)
+	{
+		usleep(us);
+		return ;
+	}
+	coro_yield(p, get_time_us() + us);
+}
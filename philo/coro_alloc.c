@@ -0,0 +1,138 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   coro_alloc.c                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: imunaev- <imunaev-@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/03/22 10:05:48 by imunaev-          #+#    #+#             */
+/*   Updated: 2025/03/22 10:05:48 by imunaev-         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file coro_alloc.c
+ * @brief Allocation and release of the coroutine engine.
+ */
+
+#include "philo.h"
+#include <sys/mman.h>
+
+/**
+ * @brief Maps the stacks of all coroutines in one region.
+ *
+ * The lowest page of every slot is made inaccessible, so a coroutine that
+ * overflows its stack faults instead of corrupting its neighbour's.
+ *
+ * @param s Pointer to the coroutine scheduler.
+ * @param n Number of coroutines.
+ * @return int Returns EXIT_SUCCESS on success, otherwise EXIT_FAILURE.
+ */
+static int	alloc_stacks(t_coro_sched *s, int n)
+{
+	long	page;
+	int		i;
+
+	page = sysconf(_SC_PAGESIZE);
+	s->slot = CORO_STACK_SIZE + page;
+	s->stacks_len = s->slot * n;
+	s->stacks = mmap(NULL, s->stacks_len, PROT_READ | PROT_WRITE,
+			MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (s->stacks == MAP_FAILED)
+	{
+		s->stacks = NULL;
+		return (EXIT_FAILURE);
+	}
+	i = 0;
+	while (i < n)
+	{
+		if (mprotect(s->stacks + i * s->slot, page, PROT_NONE) != 0)
+			return (EXIT_FAILURE);
+		i++;
+	}
+	return (EXIT_SUCCESS);
+}
+
+/**
+ * @brief Prepares the coroutine of philosopher `i` and its carrier range.
+ *
+ * Philosophers are split into contiguous blocks, one per carrier, so that
+ * neighbours sharing a fork usually run on the same carrier.
+ *
+ * @param env Pointer to the environment structure.
+ * @param i Index of the philosopher.
+ * @return int Returns EXIT_SUCCESS on success, otherwise EXIT_FAILURE.
+ */
+static int	init_coro(t_env *env, int i)
+{
+	t_coro_sched	*s;
+	t_coro			*co;
+
+	s = env->coro;
+	co = &s->coros[i];
+	co->carrier = &s->carriers[i / s->block];
+	co->carrier->env = env;
+	co->carrier->lo = (i / s->block) * s->block;
+	co->carrier->hi = i + 1;
+	return (coro_ctx_init(&co->ctx, s->stacks + i * s->slot
+			+ (s->slot - CORO_STACK_SIZE), CORO_STACK_SIZE, &env->philos[i]));
+}
+
+/**
+ * @brief Allocates the coroutine engine when `--engine=coro` is selected.
+ *
+ * The carrier count follows `--workers` like the worker pool. The start
+ * gate then waits for the carriers instead of the philosophers.
+ *
+ * @param env Pointer to the environment structure.
+ * @return int Returns EXIT_SUCCESS if allocation is successful, otherwise
+ * returns EXIT_FAILURE.
+ */
+int	alloc_coro(t_env *env)
+{
+	t_coro_sched	*s;
+	int				i;
+
+	if (env->opts.engine != ENGINE_CORO)
+		return (EXIT_SUCCESS);
+	s = calloc(1, sizeof(t_coro_sched));
+	if (!s || pthread_mutex_init(&s->park_mutex, NULL) != 0)
+	{
+		free(s);
+		return (EXIT_FAILURE);
+	}
+	env->coro = s;
+	s->block = (env->cfg.num_philo + pool_size(env) - 1) / pool_size(env);
+	s->num_carriers = (env->cfg.num_philo + s->block - 1) / s->block;
+	env->start_expected = s->num_carriers;
+	s->coros = calloc(env->cfg.num_philo, sizeof(t_coro));
+	s->carriers = calloc(s->num_carriers, sizeof(t_carrier));
+	if (!s->coros || !s->carriers
+		|| alloc_stacks(s, env->cfg.num_philo) == EXIT_FAILURE)
+		return (EXIT_FAILURE);
+	i = 0;
+	while (i < env->cfg.num_philo && init_coro(env, i) == EXIT_SUCCESS)
+		i++;
+	return (i < env->cfg.num_philo);
+}
+
+/**
+ * @brief Releases the coroutine engine.
+ *
+ * @param env Pointer to the environment structure.
+ */
+void	free_coro(t_env *env)
+{
+	t_coro_sched	*s;
+
+	s = env->coro;
+	if (!s)
+		return ;
+	if (s->stacks)
+		(void)munmap(s->stacks, s->stacks_len);
+	free(s->coros);
+	free(s->carriers);
+	(void)pthread_mutex_destroy(&s->park_mutex);
+	free(s);
+	env->coro = NULL;
+}
@@ -0,0 +1,171 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   coro_carrier.c                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: imunaev- <imunaev-@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/03/22 10:47:13 by imunaev-          #+#    #+#             */
+/*   Updated: 2025/03/22 10:47:13 by imunaev-         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file coro_carrier.c
+ * @brief Carrier threads of the coroutine engine.
+ *
+ * Each carrier repeatedly resumes those of its coroutines whose wake-up
+ * time has passed, and sleeps until the earliest remaining one when none
+ * is runnable. A coroutine runs until its next blocking point, so a
+ * switch costs a context swap instead of a kernel reschedule. The sleep
+ * is a futex wait on the carrier's `kick` word, so that a coroutine
+ * releasing a fork can end it early.
+ */
+
+#include "philo.h"
+#include <limits.h>
+
+/**
+ * @brief Resumes every runnable coroutine of the carrier once.
+ *
+ * @param c Pointer to the carrier.
+ * @param alive Set to the number of coroutines that have not finished.
+ * @return long Earliest wake-up time in microseconds among the unfinished
+ * coroutines, or LONG_MAX if there is none.
+ */
+static long	carrier_round(t_carrier *c, int *alive)
+{
+	t_coro	*co;
+	long	next;
+	int		i;
+
+	next = LONG_MAX;
+	*alive = 0;
+	i = c->lo;
+	while (i < c->hi)
+	{
+		co = &c->env->coro->coros[i];
+		if (!co->done && co->wake_at <= get_time_us())
+		{
+			coro_switch(&c->sched, &co->ctx);
+			c->switches++;
+		}
+		if (!co->done && co->wake_at < next)
+			next = co->wake_at;
+		if (!co->done)
+			(*alive)++;
+		i++;
+	}
+	return (next);
+}
+
+/**
+ * @brief Waits on the start gate and hands the lag to the philosophers.
+ *
+ * @param c Pointer to the carrier.
+ */
+static void	carrier_start(t_carrier *c)
+{
+	long	lag;
+	int		i;
+
+	announce_ready(c->env);
+	lag = await_start(c->env);
+	i = c->lo;
+	while (i < c->hi)
+	{
+		c->env->philos[i].start_lag = lag;
+		i++;
+	}
+}
+
+/**
+ * @brief Carrier thread function.
+ *
+ * Waits on the start gate like a philosopher thread would, then schedules
+ * its philosophers until all of them returned from `routine()`. `kick` is
+ * read before each round, so a wake-up that comes after the round looked
+ * at a parked coroutine skips or ends the next sleep.
+ *
+ * @param arg Pointer to the carrier (`t_carrier`).
+ * @return NULL when the carrier exits.
+ */
+static void	*carrier_main(void *arg)
+{
+	t_carrier	*c;
+	uint32_t	seen;
+	long		lag;
+	long		next;
+	int			alive;
+
+	c = (t_carrier *)arg;
+	carrier_start(c);
+	seen = atomic_load(&c->kick);
+	next = carrier_round(c, &alive);
+	while (alive > 0)
+	{
+		lag = next - get_time_us();
+		if (lag > 0 && atomic_load(&c->kick) == seen)
+			futex_wait_us(&c->kick, seen, lag);
+		seen = atomic_load(&c->kick);
+		next = carrier_round(c, &alive);
+	}
+	return (NULL);
+}
+
+/**
+ * @brief Creates the carrier threads of the coroutine engine.
+ *
+ * If a thread fails to create, it sets `env->ended` to true and opens the
+ * start gate so that the carriers already created can exit.
+ *
+ * Thread safety:
+ * - Uses `end_mutex` to safely update the `ended` flag upon failure.
+ *
+ * @param env Pointer to the environment structure.
+ * @return int Returns EXIT_SUCCESS if all threads are created successfully,
+ * otherwise EXIT_FAILURE.
+ */
+int	create_coro_carriers(t_env *env)
+{
+	t_coro_sched	*s;
+
+	s = env->coro;
+	while (s->created < s->num_carriers)
+	{
+		if (start_thread(env, &s->carriers[s->created].thread,
+				carrier_main, &s->carriers[s->created]) != 0)
+		{
+			print_error("Error: Failed to create coroutine carrier thread\n");
+			stat_lock(env, &env->end_mutex, LOCK_END);
+			env->ended = true;
+			pthread_mutex_unlock(&env->end_mutex);
+			wake_monitors(env);
+			release_start_gate(env, get_time());
+			return (EXIT_FAILURE);
+		}
+		place_thread(env, s->carriers[s->created].thread,
+			s->carriers[s->created].lo);
+		s->created++;
+	}
+	return (EXIT_SUCCESS);
+}
+
+/**
+ * @brief Joins every carrier thread that was created.
+ *
+ * @param env Pointer to the environment structure.
+ */
+void	join_coro_carriers(t_env *env)
+{
+	int	i;
+
+	if (!env->coro)
+		return ;
+	i = 0;
+	while (i < env->coro->created)
+	{
+		pthread_join(env->coro->carriers[i].thread, NULL);
+		i++;
+	}
+}
@@ -0,0 +1,118 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   coro_forks.c                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: imunaev- <imunaev-@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 10:31:05 by imunaev-          #+#    #+#             */
+/*   Updated: 2026/10/19 10:31:05 by imunaev-         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file coro_forks.c
+ * @brief Fork waiting for philosophers run as coroutines.
+ *
+ * A hungry coroutine that cannot take its forks is parked, like a
+ * philosopher of the worker pool (see `pool_forks.c`): its carrier skips
+ * it until the neighbour that releases a shared fork makes it runnable
+ * again. A neighbour on another carrier also kicks that carrier out of
+ * its sleep.
+ */
+
+#include "philo.h"
+#include <limits.h>
+
+/**
+ * @brief Tries to take both forks, parking the coroutine on failure.
+ *
+ * The second attempt and the parking happen under `park_mutex`, and a
+ * releasing neighbour takes the same mutex after freeing its forks, so a
+ * release can never slip between the attempt and the parking. A pair of
+ * forks straddling a bitmap word is only tried in the second attempt, as
+ * in `pool_try_eat()`.
+ *
+ * @param p Pointer to the philosopher structure.
+ * @return true if the philosopher holds both forks, false if it is parked.
+ */
+static bool	coro_try_eat(t_philo *p)
+{
+	t_coro_sched	*s;
+	bool			taken;
+
+	if (bitmap_try_take_forks(p, false))
+		return (true);
+	s = p->env->coro;
+	pthread_mutex_lock(&s->park_mutex);
+	taken = bitmap_try_take_forks(p, true);
+	if (!taken)
+	{
+		p->waiting = true;
+		p->coro->wake_at = LONG_MAX;
+	}
+	pthread_mutex_unlock(&s->park_mutex);
+	return (taken);
+}
+
+/**
+ * @brief Takes both forks without blocking the carrier thread.
+ *
+ * While the forks are taken, the coroutine stays parked and its carrier
+ * runs the others. It is resumed by `coro_wake_neighbours()` and tries
+ * again.
+ *
+ * @param p Pointer to the philosopher structure.
+ */
+void	coro_take_forks(t_philo *p)
+{
+	while (!coro_try_eat(p))
+		coro_switch(&p->coro->ctx, &p->coro->carrier->sched);
+	print_status(p, "has taken a fork");
+	print_status(p, "has taken a fork");
+}
+
+/**
+ * @brief Makes a parked philosopher runnable again.
+ *
+ * The caller holds `park_mutex`. Bumping `kick` keeps the carrier from
+ * sleeping past the philosopher if its round already skipped it; the
+ * futex wake is only needed when the philosopher belongs to another
+ * carrier, which may be asleep.
+ *
+ * @param env Pointer to the environment structure.
+ * @param self The carrier running the caller.
+ * @param id Index of the philosopher.
+ */
+static void	wake_one(t_env *env, t_carrier *self, int id)
+{
+	t_coro	*co;
+
+	if (!env->philos[id].waiting)
+		return ;
+	env->philos[id].waiting = false;
+	co = env->philos[id].coro;
+	co->wake_at = 0;
+	atomic_fetch_add(&co->carrier->kick, 1);
+	if (co->carrier != self)
+		futex_wake(&co->carrier->kick, 1);
+}
+
+/**
+ * @brief Wakes the neighbours that share a fork with philosopher `id`.
+ *
+ * Called after the philosopher released its forks.
+ *
+ * @param env Pointer to the environment structure.
+ * @param id Index of the philosopher that released its forks.
+ */
+void	coro_wake_neighbours(t_env *env, int id)
+{
+	t_carrier	*self;
+
+	self = env->philos[id].coro->carrier;
+	pthread_mutex_lock(&env->coro->park_mutex);
+	wake_one(env, self, (id + env->cfg.num_philo - 1) % env->cfg.num_philo);
+	wake_one(env, self, (id + 1) % env->cfg.num_philo);
+	pthread_mutex_unlock(&env->coro->park_mutex);
+}
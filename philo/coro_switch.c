@@ -0,0 +1,143 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   coro_switch.c                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: imunaev- <imunaev-@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 10:12:40 by imunaev-          #+#    #+#             */
+/*   Updated: 2026/10/19 10:12:40 by imunaev-         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file coro_switch.c
+ * @brief Context switch between coroutines and their carrier.
+ *
+ * `swapcontext()` also saves and restores the signal mask, which costs an
+ * `rt_sigprocmask` system call on every switch. On x86-64 the switch is
+ * done here instead: it pushes the callee-saved registers on the current
+ * stack, stores the stack pointer, loads the other one and pops its
+ * registers, all in user space. The simulation never changes the signal
+ * mask or the floating-point control state, so nothing else needs to
+ * follow a coroutine. Other architectures keep `swapcontext()`.
+ */
+
+#include "philo.h"
+
+#if defined(__x86_64__)
+
+__asm__ (
+	".text\n"
+	".globl coro_switch\n"
+	".type coro_switch, @function\n"
+	"coro_switch:\n"
+	"	pushq %rbp\n"
+	"	pushq %rbx\n"
+	"	pushq %r12\n"
+	"	pushq %r13\n"
+	"	pushq %r14\n"
+	"	pushq %r15\n"
+	"	movq %rsp, (%rdi)\n"
+	"	movq (%rsi), %rsp\n"
+	"	popq %r15\n"
+	"	popq %r14\n"
+	"	popq %r13\n"
+	"	popq %r12\n"
+	"	popq %rbx\n"
+	"	popq %rbp\n"
+	"	ret\n"
+	".size coro_switch, .-coro_switch\n"
+	".globl coro_trampoline\n"
+	".hidden coro_trampoline\n"
+	".type coro_trampoline, @function\n"
+	"coro_trampoline:\n"
+	"	movq %r12, %rdi\n"
+	"	call coro_entry\n"
+	"	ud2\n"
+	".size coro_trampoline, .-coro_trampoline\n"
+);
+
+void	coro_trampoline(void);
+
+/**
+ * @brief Prepares a coroutine to start in `coro_entry(p)`.
+ *
+ * The top of the stack is laid out as if `coro_switch()` had suspended
+ * it: six zeroed registers (with `p` in `%r12`), then `coro_trampoline`
+ * as the return address, which moves `p` into the argument register and
+ * calls `coro_entry()` with the stack aligned as the ABI requires.
+ *
+ * @param ctx The context to prepare.
+ * @param stack Lowest address of the coroutine's stack.
+ * @param size Size of the stack in bytes.
+ * @param p Pointer to the philosopher structure.
+ * @return int Always EXIT_SUCCESS.
+ */
+int	coro_ctx_init(t_coro_ctx *ctx, char *stack, size_t size, t_philo *p)
+{
+	void	**sp;
+	int		i;
+
+	sp = (void **)(((uintptr_t)stack + size) & ~(uintptr_t)15) - 9;
+	i = 0;
+	while (i < 9)
+	{
+		sp[i] = NULL;
+		i++;
+	}
+	sp[3] = p;
+	sp[6] = (void *)coro_trampoline;
+	ctx->sp = sp;
+	return (EXIT_SUCCESS);
+}
+
+#else
+
+/**
+ * @brief Entry point given to `makecontext()`.
+ *
+ * `makecontext()` only passes `int` arguments, so the philosopher pointer
+ * arrives split into its high and low 32 bits.
+ *
+ * @param hi High 32 bits of the `t_philo` pointer.
+ * @param lo Low 32 bits of the `t_philo` pointer.
+ */
+static void	coro_start(unsigned int hi, unsigned int lo)
+{
+	coro_entry((t_philo *)(((uintptr_t)hi << 32) | (uintptr_t)lo));
+}
+
+/**
+ * @brief Suspends the context `from` and resumes `to`.
+ *
+ * @param from Where the current context is saved.
+ * @param to The context to resume.
+ */
+void	coro_switch(t_coro_ctx *from, t_coro_ctx *to)
+{
+	(void)swapcontext(&from->uc, &to->uc);
+}
+
+/**
+ * @brief Prepares a coroutine to start in `coro_entry(p)`.
+ *
+ * @param ctx The context to prepare.
+ * @param stack Lowest address of the coroutine's stack.
+ * @param size Size of the stack in bytes.
+ * @param p Pointer to the philosopher structure.
+ * @return int Returns EXIT_SUCCESS on success, otherwise EXIT_FAILURE.
+ */
+int	coro_ctx_init(t_coro_ctx *ctx, char *stack, size_t size, t_philo *p)
+{
+	if (getcontext(&ctx->uc) != 0)
+		return (EXIT_FAILURE);
+	ctx->uc.uc_stack.ss_sp = stack;
+	ctx->uc.uc_stack.ss_size = size;
+	ctx->uc.uc_link = NULL;
+	makecontext(&ctx->uc, (void (*)(void))coro_start, 2,
+		(unsigned int)((uintptr_t)p >> 32), (unsigned int)(uintptr_t)p);
+	return (EXIT_SUCCESS);
+}
+
+#endif
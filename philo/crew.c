@@ -0,0 +1,193 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   crew.c                                             :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: imunaev- <imunaev-@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 17:40:12 by imunaev-          #+#    #+#             */
+/*   Updated: 2026/10/19 17:40:12 by imunaev-         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file crew.c
+ * @brief Threads a `--batch` runner reuses across its runs.
+ *
+ * Creating and joining the philosopher, pool worker, carrier and monitor
+ * threads of every run would cost more than the short runs of a sweep
+ * themselves. Each runner therefore keeps a crew, sized for the largest
+ * run of the batch: a run hands its thread functions to parked crew
+ * members instead of creating threads (`start_thread()`), and waits for
+ * them to park again instead of joining them (`crew_wait()`).
+ */
+
+#define _GNU_SOURCE
+#include "philo.h"
+#include <errno.h>
+#include <sched.h>
+
+/**
+ * @brief Crew thread: runs the tasks it is handed until told to exit.
+ *
+ * Between tasks the thread parks on its state word. A task that pinned
+ * the thread (`--placement=numa`, several monitor shards) would leave it
+ * pinned for the next run, so with `repin` the original mask is restored.
+ *
+ * @param arg Pointer to the member (`t_crew_member`).
+ * @return NULL when the crew stops.
+ */
+static void	*crew_main(void *arg)
+{
+	t_crew_member	*m;
+	cpu_set_t		mask;
+	uint32_t		state;
+
+	m = (t_crew_member *)arg;
+	(void)pthread_getaffinity_np(pthread_self(), sizeof(mask), &mask);
+	state = atomic_load(&m->state);
+	while (state != CREW_EXIT)
+	{
+		if (state == CREW_IDLE)
+			futex_wait(&m->state, CREW_IDLE);
+		else
+		{
+			m->fn(m->arg);
+			if (m->crew->repin)
+				(void)pthread_setaffinity_np(pthread_self(), sizeof(mask),
+					&mask);
+			atomic_store(&m->state, CREW_IDLE);
+			futex_wake(&m->state, 1);
+		}
+		state = atomic_load(&m->state);
+	}
+	return (NULL);
+}
+
+/**
+ * @brief Prepares an empty crew of up to `capacity` threads.
+ *
+ * No thread is created yet: runs create the members they need.
+ *
+ * @param c The crew.
+ * @param opts Run-time options of the batch.
+ * @param capacity Most threads one run needs.
+ * @return int Returns EXIT_SUCCESS if the crew is ready, otherwise
+ * EXIT_FAILURE.
+ */
+int	crew_init(t_crew *c, const t_opts *opts, int capacity)
+{
+	c->members = malloc(capacity * sizeof(t_crew_member));
+	if (!c->members)
+		return (EXIT_FAILURE);
+	if (init_thread_attr(capacity, &c->attr) == EXIT_FAILURE)
+	{
+		free(c->members);
+		return (EXIT_FAILURE);
+	}
+	c->capacity = capacity;
+	c->created = 0;
+	c->used = 0;
+	c->repin = (opts->placement == PLACE_NUMA || opts->shards > 1);
+	return (EXIT_SUCCESS);
+}
+
+/**
+ * @brief Runs `fn(arg)` on a new thread, or on the next crew member.
+ *
+ * Without a crew this is `pthread_create()` with default attributes.
+ * With one, the next member not yet used by the run gets the task, and is
+ * created first if no earlier run needed it. `*thread` then names the
+ * member, so the caller can pin it, but it must not be joined.
+ *
+ * Thread safety:
+ * - A crew is only handed tasks by its runner thread.
+ *
+ * @param env Pointer to the environment structure.
+ * @param thread Receives the thread running the task.
+ * @param fn Thread function.
+ * @param arg Argument of `fn`.
+ * @return int 0 on success, otherwise an error number.
+ */
+int	start_thread(t_env *env, pthread_t *thread, void *(*fn)(void *),
+		void *arg)
+{
+	t_crew			*c;
+	t_crew_member	*m;
+
+	c = env->crew;
+	if (!c)
+		return (pthread_create(thread, NULL, fn, arg));
+	if (c->used == c->capacity)
+		return (EAGAIN);
+	m = &c->members[c->used];
+	if (c->used == c->created)
+	{
+		m->crew = c;
+		atomic_init(&m->state, CREW_IDLE);
+		if (pthread_create(&m->thread, &c->attr, crew_main, m) != 0)
+			return (EAGAIN);
+		c->created++;
+	}
+	m->fn = fn;
+	m->arg = arg;
+	atomic_store(&m->state, CREW_BUSY);
+	futex_wake(&m->state, 1);
+	*thread = m->thread;
+	c->used++;
+	return (0);
+}
+
+/**
+ * @brief Spawner function handing the philosophers of one slice to the
+ * crew.
+ *
+ * The crew counterpart of `spawn_slice()`: creation stops at the first
+ * failure, and `done` then counts the philosophers started.
+ *
+ * @param arg Pointer to the slice (`t_spawner`).
+ * @return NULL when the slice is done.
+ */
+void	*crew_slice(void *arg)
+{
+	t_spawner	*sp;
+	t_philo		*p;
+
+	sp = (t_spawner *)arg;
+	while (sp->lo + sp->done < sp->hi)
+	{
+		p = &sp->env->philos[sp->lo + sp->done];
+		if (start_thread(sp->env, &p->thread, routine, p) != 0)
+		{
+			sp->status = EXIT_FAILURE;
+			break ;
+		}
+		place_thread(sp->env, p->thread, p->id);
+		sp->done++;
+	}
+	return (NULL);
+}
+
+/**
+ * @brief Stops and joins every crew thread, then frees the crew.
+ *
+ * Must only be called once the last run's tasks returned
+ * (`crew_wait()`).
+ *
+ * @param c The crew.
+ */
+void	crew_stop(t_crew *c)
+{
+	int	i;
+
+	i = 0;
+	while (i < c->created)
+	{
+		atomic_store(&c->members[i].state, CREW_EXIT);
+		futex_wake(&c->members[i].state, 1);
+		pthread_join(c->members[i].thread, NULL);
+		i++;
+	}
+	(void)pthread_attr_destroy(&c->attr);
+	free(c->members);
+}
@@ -0,0 +1,138 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   deadline_heap.c                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: imunaev- <imunaev-@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/03/19 15:21:40 by imunaev-          #+#    #+#             */
+/*   Updated: 2025/03/19 15:21:40 by imunaev-         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file deadline_heap.c
+ * @brief Indexed min-heap of philosopher deadlines.
+ *
+ * The monitor keys it by death deadline, the first millisecond at which a
+ * philosopher counts as dead (`last_meal + die_time + 1`, with each
+ * philosopher's own die time); these only move forward, so an update is a
+ * single sift-down. The worker pool reuses the
+ * same heap keyed by each philosopher's next timer, which can also move
+ * backward. The earliest key is always at the root.
+ */
+
+#include "philo.h"
+
+/**
+ * @brief Swaps two heap slots and keeps the position index in sync.
+ *
+ * @param h Pointer to the deadline heap.
+ * @param a First heap slot.
+ * @param b Second heap slot.
+ */
+static void	heap_swap(t_deadline_heap *h, int a, int b)
+{
+	int	tmp;
+
+	tmp = h->heap[a];
+	h->heap[a] = h->heap[b];
+	h->heap[b] = tmp;
+	h->pos[h->heap[a]] = a;
+	h->pos[h->heap[b]] = b;
+}
+
+/**
+ * @brief Moves the entry at slot `i` down until the heap order holds.
+ *
+ * @param h Pointer to the deadline heap.
+ * @param i Heap slot whose deadline was increased.
+ */
+static void	sift_down(t_deadline_heap *h, int i)
+{
+	int	child;
+
+	child = (i << 1) + 1;
+	while (child < h->size)
+	{
+		if (child + 1 < h->size
+			&& h->deadline[h->heap[child + 1]] < h->deadline[h->heap[child]])
+			child++;
+		if (h->deadline[h->heap[i]] <= h->deadline[h->heap[child]])
+			return ;
+		heap_swap(h, i, child);
+		i = child;
+		child = (i << 1) + 1;
+	}
+}
+
+/**
+ * @brief Moves the entry at slot `i` up until the heap order holds.
+ *
+ * @param h Pointer to the heap.
+ * @param i Heap slot whose key was decreased.
+ */
+static void	sift_up(t_deadline_heap *h, int i)
+{
+	int	parent;
+
+	while (i > 0)
+	{
+		parent = (i - 1) >> 1;
+		if (h->deadline[h->heap[parent]] <= h->deadline[h->heap[i]])
+			return ;
+		heap_swap(h, i, parent);
+		i = parent;
+	}
+}
+
+/**
+ * @brief Changes the key of local entry `i` and restores the heap order.
+ *
+ * The caller holds the heap mutex (if the heap is shared).
+ *
+ * @param h Pointer to the heap.
+ * @param i Local index of the entry.
+ * @param key New key in milliseconds.
+ */
+void	heap_set_key(t_deadline_heap *h, int i, long key)
+{
+	long	old;
+
+	old = h->deadline[i];
+	h->deadline[i] = key;
+	if (key < old)
+		sift_up(h, h->pos[i]);
+	else
+		sift_down(h, h->pos[i]);
+}
+
+/**
+ * @brief Builds the heap from one key per entry.
+ *
+ * Called while no other thread uses the heap. The entries are laid out in
+ * identity order and sifted down from the last parent up, which orders
+ * them in linear time.
+ *
+ * @param h Pointer to the heap.
+ * @param keys Key of each local entry.
+ */
+void	heap_build(t_deadline_heap *h, const long *keys)
+{
+	int	i;
+
+	i = 0;
+	while (i < h->size)
+	{
+		h->heap[i] = i;
+		h->pos[i] = i;
+		h->deadline[i] = keys[i];
+		i++;
+	}
+	i = h->size / 2;
+	while (i > 0)
+	{
+		i--;
+		sift_down(h, i);
+	}
+}
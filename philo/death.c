@@ -0,0 +1,51 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   death.c                                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: imunaev- <imunaev-@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 14:11:52 by imunaev-          #+#    #+#             */
+/*   Updated: 2026/10/19 14:11:52 by imunaev-         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file death.c
+ * @brief Announcement of the death that ends a simulation.
+ */
+
+#include "philo.h"
+
+/**
+ * @brief Records and prints the death of philosopher `i`.
+ *
+ * Keeps who died, when, and how long after the deadline the death was
+ * detected, prints the `died` line (unless the run is quiet, as in batch
+ * mode) and passes the death on to `--live` and `--trace`.
+ *
+ * Thread safety:
+ * - Called once per run, by the monitor that set `ended`. The fields it
+ *   writes are read after every thread was joined.
+ * - Uses `print_mutex` to print the death message without race conditions.
+ *
+ * @param env Pointer to the environment structure.
+ * @param i Index of the philosopher that died.
+ * @param now Time of detection in microseconds.
+ * @param deadline The philosopher's death deadline in milliseconds.
+ */
+void	announce_death(t_env *env, int i, long now, long deadline)
+{
+	env->dead = i + 1;
+	env->dead_at = now / 1000 - env->start_time;
+	env->death_latency = now - deadline * 1000;
+	DTRACE_PROBE2(philo, death, i + 1, env->death_latency);
+	if (!env->opts.quiet)
+	{
+		stat_lock(env, &env->print_mutex, LOCK_PRINT);
+		printf("%ld %d died\n", env->dead_at, i + 1);
+		pthread_mutex_unlock(&env->print_mutex);
+	}
+	live_died(env, i);
+	trace_died(env, i, env->dead_at);
+}
@@ -0,0 +1,155 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   fork_bitmap.c                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: imunaev- <imunaev-@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/03/19 10:44:52 by imunaev-          #+#    #+#             */
+/*   Updated: 2025/03/19 10:44:52 by imunaev-         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file fork_bitmap.c
+ * @brief Lock-free fork acquisition on an atomic bitmap.
+ *
+ * Forks are stored as one bit each in an array of 64-bit atomic words.
+ * When both forks of a philosopher live in the same word they are taken
+ * with a single compare-and-swap on a two-bit mask. A pair that straddles
+ * a word boundary (including the wrap-around between the last and the first
+ * philosopher) is taken one bit at a time in ascending fork order, which
+ * keeps the global acquisition order acyclic and therefore deadlock-free.
+ */
+
+#include "philo.h"
+#include <limits.h>
+
+/**
+ * @brief Parks the calling thread until the busy bits may have changed.
+ *
+ * The waiter count is raised before the futex re-checks the word, so a
+ * releasing thread either sees the waiter or the waiter sees the release.
+ *
+ * @param t Pointer to the fork table.
+ * @param w Index of the word holding the forks.
+ * @param busy The requested bits that were found taken.
+ * @param seen The word value observed by the caller.
+ */
+static void	park(t_fork_table *t, int w, uint64_t busy, uint64_t seen)
+{
+	int	high;
+
+	high = !(busy & 0xffffffffULL);
+	atomic_fetch_add(&t->waiters[w], 1);
+	futex_wait(futex_half(&t->words[w], high),
+		(uint32_t)(seen >> (high << 5)));
+	atomic_fetch_sub(&t->waiters[w], 1);
+}
+
+/**
+ * @brief Atomically sets all bits of `mask` in word `w`, waiting if needed.
+ *
+ * @param t Pointer to the fork table.
+ * @param w Index of the word holding the forks.
+ * @param mask Bits of the forks to take.
+ */
+static void	take_mask(t_fork_table *t, int w, uint64_t mask)
+{
+	uint64_t	old;
+
+	old = atomic_load_explicit(&t->words[w], memory_order_relaxed);
+	while (1)
+	{
+		if (!(old & mask))
+		{
+			if (atomic_compare_exchange_weak_explicit(&t->words[w], &old,
+					old | mask, memory_order_acquire, memory_order_relaxed))
+				return ;
+		}
+		else
+		{
+			park(t, w, old & mask, old);
+			old = atomic_load_explicit(&t->words[w], memory_order_relaxed);
+		}
+	}
+}
+
+/**
+ * @brief Clears the bits of `mask` in word `w` and wakes parked waiters.
+ *
+ * The futex wake is skipped entirely when nobody waits on the word.
+ *
+ * @param t Pointer to the fork table.
+ * @param w Index of the word holding the forks.
+ * @param mask Bits of the forks to release.
+ */
+static void	release_mask(t_fork_table *t, int w, uint64_t mask)
+{
+	atomic_fetch_and(&t->words[w], ~mask);
+	if (atomic_load(&t->waiters[w]) == 0)
+		return ;
+	if (mask & 0xffffffffULL)
+		futex_wake(futex_half(&t->words[w], 0), INT_MAX);
+	if (mask >> 32)
+		futex_wake(futex_half(&t->words[w], 1), INT_MAX);
+}
+
+/**
+ * @brief Takes both forks of a philosopher from the fork bitmap.
+ *
+ * Thread safety:
+ * - Forks are claimed with atomic compare-and-swap, no mutex is used.
+ *
+ * @param p Pointer to the philosopher structure.
+ */
+void	bitmap_take_forks(t_philo *p)
+{
+	t_fork_table	*t;
+	int				lo;
+	int				hi;
+
+	t = &p->env->fork_table;
+	lo = p->id;
+	hi = (p->id + 1) % p->env->cfg.num_philo;
+	if (hi < lo)
+	{
+		lo = hi;
+		hi = p->id;
+	}
+	if (lo / FORK_WORD_BITS == hi / FORK_WORD_BITS)
+		take_mask(t, lo / FORK_WORD_BITS, (1ULL << (lo % FORK_WORD_BITS))
+			| (1ULL << (hi % FORK_WORD_BITS)));
+	else
+	{
+		take_mask(t, lo / FORK_WORD_BITS, 1ULL << (lo % FORK_WORD_BITS));
+		take_mask(t, hi / FORK_WORD_BITS, 1ULL << (hi % FORK_WORD_BITS));
+	}
+	print_status(p, "has taken a fork");
+	print_status(p, "has taken a fork");
+}
+
+/**
+ * @brief Releases both forks of a philosopher in the fork bitmap.
+ *
+ * @param p Pointer to the philosopher structure.
+ */
+void	bitmap_put_forks(t_philo *p)
+{
+	t_fork_table	*t;
+	int				l;
+	int				r;
+
+	DTRACE_PROBE1(philo, fork_release, p->id + 1);
+	t = &p->env->fork_table;
+	l = p->id;
+	r = (p->id + 1) % p->env->cfg.num_philo;
+	if (l / FORK_WORD_BITS == r / FORK_WORD_BITS)
+		release_mask(t, l / FORK_WORD_BITS, (1ULL << (l % FORK_WORD_BITS))
+			| (1ULL << (r % FORK_WORD_BITS)));
+	else
+	{
+		release_mask(t, l / FORK_WORD_BITS, 1ULL << (l % FORK_WORD_BITS));
+		release_mask(t, r / FORK_WORD_BITS, 1ULL << (r % FORK_WORD_BITS));
+	}
+}
@@ -0,0 +1,92 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   futex.c                                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: imunaev- <imunaev-@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/03/19 10:31:17 by imunaev-          #+#    #+#             */
+/*   Updated: 2025/03/19 10:31:17 by imunaev-         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file futex.c
+ * @brief Thin wrappers around the Linux `futex` system call.
+ *
+ * These are used to park threads on a 32-bit word until another thread
+ * changes it, without a mutex/condition variable pair.
+ */
+
+#include "philo.h"
+#include <linux/futex.h>
+#include <sys/syscall.h>
+
+/**
+ * @brief Blocks while the 32-bit word at `addr` still equals `expected`.
+ *
+ * Returns immediately if the value already changed. Spurious wake-ups are
+ * possible, so callers must re-check their condition in a loop.
+ *
+ * @param addr Address of the 32-bit futex word.
+ * @param expected Value the word must hold for the thread to sleep.
+ * @return long The raw `syscall()` result.
+ */
+long	futex_wait(void *addr, uint32_t expected)
+{
+	return (syscall(SYS_futex, addr, FUTEX_WAIT_PRIVATE, expected,
+			NULL, NULL, 0));
+}
+
+/**
+ * @brief Like `futex_wait()`, but gives up after `us` microseconds.
+ *
+ * @param addr Address of the 32-bit futex word.
+ * @param expected Value the word must hold for the thread to sleep.
+ * @param us Longest time to sleep in microseconds.
+ * @return long The raw `syscall()` result.
+ */
+long	futex_wait_us(void *addr, uint32_t expected, long us)
+{
+	struct timespec	ts;
+
+	ts.tv_sec = us / 1000000;
+	ts.tv_nsec = (us % 1000000) * 1000;
+	return (syscall(SYS_futex, addr, FUTEX_WAIT_PRIVATE, expected,
+			&ts, NULL, 0));
+}
+
+/**
+ * @brief Returns the address of one 32-bit half of a 64-bit word.
+ *
+ * Futexes operate on 32-bit values, so a thread waiting for bits of a
+ * 64-bit word parks on the half that holds them. The byte order check is
+ * folded by the compiler.
+ *
+ * @param word Address of the 64-bit word.
+ * @param high Non-zero for the half holding bits 32..63.
+ * @return uint32_t* Address of the requested half.
+ */
+uint32_t	*futex_half(void *word, int high)
+{
+	uint64_t	one;
+	int			low_index;
+
+	one = 1;
+	low_index = (*(uint32_t *)&one != 1);
+	if (high)
+		return ((uint32_t *)word + !low_index);
+	return ((uint32_t *)word + low_index);
+}
+
+/**
+ * @brief Wakes up to `count` threads parked on `addr`.
+ *
+ * @param addr Address of the 32-bit futex word.
+ * @param count Maximum number of threads to wake.
+ */
+void	futex_wake(void *addr, int count)
+{
+	(void)syscall(SYS_futex, addr, FUTEX_WAKE_PRIVATE, count,
+		NULL, NULL, 0);
+}
@@ -0,0 +1,134 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   grants.c                                           :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: imunaev- <imunaev-@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 11:20:37 by imunaev-          #+#    #+#             */
+/*   Updated: 2026/10/19 11:20:37 by imunaev-         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file grants.c
+ * @brief Recording and replay of the order in which forks are granted.
+ *
+ * Each fork counts its grants. A philosopher that holds both of its forks
+ * takes the next ticket of each (`grant_record()`); the tickets fix the
+ * order in which the two neighbours sharing a fork got it, and therefore
+ * in which waiters were woken and served. `--record` keeps every
+ * philosopher's tickets in its own log and writes them at exit;
+ * `--replay` loads them and makes each philosopher wait until both of its
+ * forks reached its recorded tickets before it tries to take them. Any
+ * engine and fork mode can replay a recording made with any other.
+ */
+
+#include "philo.h"
+
+/**
+ * @brief Appends the tickets of one meal to a grant log.
+ *
+ * If the log cannot grow, `cap` is set to -1 and the recording is lost
+ * (see `free_grants()`).
+ *
+ * @param log Pointer to the philosopher's grant log.
+ * @param left Ticket of the philosopher's own fork.
+ * @param right Ticket of its right fork.
+ */
+static void	grant_push(t_grant_log *log, long left, long right)
+{
+	long	*tickets;
+
+	if (log->cap < 0)
+		return ;
+	if (log->count + 2 > log->cap)
+	{
+		tickets = realloc(log->tickets, (log->cap * 2 + 64) * sizeof(long));
+		if (!tickets)
+		{
+			log->cap = -1;
+			return ;
+		}
+		log->tickets = tickets;
+		log->cap = log->cap * 2 + 64;
+	}
+	log->tickets[log->count] = left;
+	log->tickets[log->count + 1] = right;
+	log->count += 2;
+}
+
+/**
+ * @brief Takes the next grant ticket of both forks of a philosopher.
+ *
+ * Called once the philosopher holds both forks, in every engine. While
+ * recording, the tickets are appended to the philosopher's log; while
+ * replaying, its cursor moves to the next meal.
+ *
+ * Thread safety:
+ * - A fork's counter is only incremented by its holder; the grant logs
+ *   are per philosopher.
+ *
+ * @param p Pointer to the philosopher structure.
+ */
+void	grant_record(t_philo *p)
+{
+	t_env	*env;
+	long	left;
+	long	right;
+
+	env = p->env;
+	if (!env->grants)
+		return ;
+	left = atomic_fetch_add_explicit(&env->grants[p->id], 1,
+			memory_order_release);
+	right = atomic_fetch_add_explicit(
+			&env->grants[(p->id + 1) % env->cfg.num_philo], 1,
+			memory_order_release);
+	if (env->opts.record)
+		grant_push(&env->grant_logs[p->id], left, right);
+	else
+		env->grant_logs[p->id].next += 2;
+}
+
+/**
+ * @brief Tells whether a replaying philosopher may take its forks now.
+ *
+ * Once the recorded meals of the philosopher are used up, its forks are
+ * granted freely again.
+ *
+ * @param p Pointer to the philosopher structure.
+ * @return true if both forks reached the recorded tickets of the next
+ * meal, or when not replaying; otherwise false.
+ */
+bool	replay_turn(t_philo *p)
+{
+	t_env		*env;
+	t_grant_log	*log;
+
+	env = p->env;
+	if (!env->opts.replay)
+		return (true);
+	log = &env->grant_logs[p->id];
+	if (log->next + 2 > log->count)
+		return (true);
+	return (atomic_load_explicit(&env->grants[p->id], memory_order_acquire)
+		== log->tickets[log->next]
+		&& atomic_load_explicit(
+			&env->grants[(p->id + 1) % env->cfg.num_philo],
+			memory_order_acquire) == log->tickets[log->next + 1]);
+}
+
+/**
+ * @brief Waits for the philosopher's turn at its forks under `--replay`.
+ *
+ * Polls every `REPLAY_POLL_US` microseconds, yielding to the carrier in
+ * the coroutine engine, and gives up once the simulation ended.
+ *
+ * @param p Pointer to the philosopher structure.
+ */
+void	replay_wait(t_philo *p)
+{
+	while (!replay_turn(p) && !should_terminate(p->env))
+		philo_wait_us(p, REPLAY_POLL_US);
+}
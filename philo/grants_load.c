@@ -0,0 +1,163 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   grants_load.c                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: imunaev- <imunaev-@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 11:20:37 by imunaev-          #+#    #+#             */
+/*   Updated: 2026/10/19 11:20:37 by imunaev-         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file grants_load.c
+ * @brief Loading of a `--record` file for `--replay`.
+ */
+
+#include "philo.h"
+
+/**
+ * @brief Reads a whole file into a NUL-terminated buffer.
+ *
+ * @param path Path of the file.
+ * @return char* The contents, to be freed by the caller, or NULL on error.
+ */
+char	*read_file(const char *path)
+{
+	FILE	*in;
+	char	*buf;
+	long	size;
+
+	in = fopen(path, "r");
+	if (!in)
+		return (NULL);
+	buf = NULL;
+	size = -1;
+	if (fseek(in, 0, SEEK_END) == 0)
+		size = ftell(in);
+	rewind(in);
+	if (size >= 0)
+		buf = malloc(size + 1);
+	if (buf && fread(buf, 1, size, in) == (size_t)size)
+		buf[size] = '\0';
+	else
+	{
+		free(buf);
+		buf = NULL;
+	}
+	fclose(in);
+	return (buf);
+}
+
+/**
+ * @brief Parses the next whitespace-separated decimal number.
+ *
+ * @param s Cursor into the buffer, moved past the number.
+ * @param out Where to store the number.
+ * @return true if a number of at most 18 digits was read, otherwise false.
+ */
+static bool	next_number(const char **s, long *out)
+{
+	const char	*p;
+
+	p = *s;
+	while (*p == ' ' || *p == '\n')
+		p++;
+	*s = p;
+	*out = 0;
+	while (*p >= '0' && *p <= '9' && p - *s < 18)
+	{
+		*out = *out * 10 + (*p - '0');
+		p++;
+	}
+	if (p == *s || (*p >= '0' && *p <= '9'))
+		return (false);
+	*s = p;
+	return (true);
+}
+
+/**
+ * @brief Parses the line of one philosopher into its grant log.
+ *
+ * @param s Cursor into the buffer, moved past the line.
+ * @param log Pointer to the philosopher's grant log.
+ * @return int Returns EXIT_SUCCESS on a well-formed line, otherwise
+ * EXIT_FAILURE.
+ */
+static int	load_log(const char **s, t_grant_log *log)
+{
+	long	meals;
+	long	k;
+
+	if (!next_number(s, &meals) || meals > (1L << 40))
+		return (EXIT_FAILURE);
+	log->tickets = malloc((meals * 2 + 1) * sizeof(long));
+	if (!log->tickets)
+		return (EXIT_FAILURE);
+	log->count = meals * 2;
+	log->cap = log->count;
+	k = 0;
+	while (k < log->count)
+	{
+		if (!next_number(s, &log->tickets[k]))
+			return (EXIT_FAILURE);
+		k++;
+	}
+	return (EXIT_SUCCESS);
+}
+
+/**
+ * @brief Checks the first line of a recording.
+ *
+ * @param s Cursor into the buffer, moved past the line.
+ * @param num_philo Number of philosophers of this run.
+ * @return true if it is a recording of `num_philo` philosophers.
+ */
+static bool	check_header(const char **s, int num_philo)
+{
+	long	n;
+
+	if (ft_strncmp(*s, GRANTS_MAGIC, ft_strlen(GRANTS_MAGIC)) != 0)
+		return (false);
+	*s += ft_strlen(GRANTS_MAGIC);
+	return (next_number(s, &n) && n == num_philo);
+}
+
+/**
+ * @brief Loads the `--replay` file into the grant logs.
+ *
+ * The recording must be of the same number of philosophers; the engine,
+ * fork mode and timings may differ from the recorded run.
+ *
+ * @param env Pointer to the environment structure.
+ * @return int Returns EXIT_SUCCESS if the recording was loaded, otherwise
+ * EXIT_FAILURE.
+ */
+int	load_grants(t_env *env)
+{
+	char		*buf;
+	const char	*s;
+	bool		ok;
+	int			i;
+
+	buf = read_file(env->opts.replay);
+	if (!buf)
+	{
+		print_error("Error: --replay: cannot read the recording file\n");
+		return (EXIT_FAILURE);
+	}
+	s = buf;
+	ok = check_header(&s, env->cfg.num_philo);
+	i = 0;
+	while (ok && i < env->cfg.num_philo)
+	{
+		ok = (load_log(&s, &env->grant_logs[i]) == EXIT_SUCCESS);
+		i++;
+	}
+	free(buf);
+	if (ok)
+		return (EXIT_SUCCESS);
+	print_error("Error: --replay: not a recording of this many philosophers\n");
+	return (EXIT_FAILURE);
+}
@@ -0,0 +1,133 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   grants_setup.c                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: imunaev- <imunaev-@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 11:20:37 by imunaev-          #+#    #+#             */
+/*   Updated: 2026/10/19 11:20:37 by imunaev-         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file grants_setup.c
+ * @brief Setup and teardown of `--record` and `--replay`.
+ *
+ * A recording is a text file: the line `philo-grants <philosophers>`,
+ * then one line per philosopher with its number of meals followed by the
+ * two tickets of every meal (see `t_grant_log`).
+ */
+
+#include "philo.h"
+
+/**
+ * @brief Sets up the grant counters and logs of `--record` or `--replay`.
+ *
+ * @param env Pointer to the environment structure.
+ * @return int Returns EXIT_SUCCESS if neither is on or the setup
+ * succeeded, otherwise EXIT_FAILURE.
+ */
+int	alloc_grants(t_env *env)
+{
+	if (!env->opts.record && !env->opts.replay)
+		return (EXIT_SUCCESS);
+	if (env->opts.record && env->opts.replay)
+	{
+		print_error("Error: --record and --replay exclude each other\n");
+		return (EXIT_FAILURE);
+	}
+	env->grants = calloc(env->cfg.num_philo, sizeof(atomic_long));
+	env->grant_logs = calloc(env->cfg.num_philo, sizeof(t_grant_log));
+	if (!env->grants || !env->grant_logs)
+		return (EXIT_FAILURE);
+	if (env->opts.replay)
+		return (load_grants(env));
+	return (EXIT_SUCCESS);
+}
+
+/**
+ * @brief Writes the line of one philosopher to the recording.
+ *
+ * @param out The recording file.
+ * @param log Pointer to the philosopher's grant log.
+ */
+static void	save_log(FILE *out, const t_grant_log *log)
+{
+	long	k;
+
+	fprintf(out, "%ld", log->count / 2);
+	k = 0;
+	while (k < log->count)
+	{
+		fprintf(out, " %ld", log->tickets[k]);
+		k++;
+	}
+	fprintf(out, "\n");
+}
+
+/**
+ * @brief Writes the grant logs to the `--record` file.
+ *
+ * @param env Pointer to the environment structure.
+ */
+static void	save_grants(t_env *env)
+{
+	FILE	*out;
+	int		i;
+	int		err;
+
+	out = fopen(env->opts.record, "w");
+	if (!out)
+	{
+		print_error("Error: --record: cannot open the recording file\n");
+		return ;
+	}
+	fprintf(out, "%s %d\n", GRANTS_MAGIC, env->cfg.num_philo);
+	i = 0;
+	while (i < env->cfg.num_philo)
+	{
+		save_log(out, &env->grant_logs[i]);
+		i++;
+	}
+	err = ferror(out);
+	if (fclose(out) != 0 || err)
+		print_error("Error: --record: writing the recording file failed\n");
+}
+
+/**
+ * @brief Saves the recording, if any, and frees the grant logs.
+ *
+ * Called after every thread was joined. Nothing is written when a log
+ * could not grow during the run.
+ *
+ * @param env Pointer to the environment structure.
+ */
+void	free_grants(t_env *env)
+{
+	bool	lost;
+	int		i;
+
+	if (env->grant_logs)
+	{
+		lost = false;
+		i = 0;
+		while (i < env->cfg.num_philo)
+		{
+			lost |= (env->grant_logs[i].cap < 0);
+			i++;
+		}
+		if (lost)
+			print_error("Error: --record: out of memory, nothing saved\n");
+		else if (env->opts.record)
+			save_grants(env);
+		i = 0;
+		while (i < env->cfg.num_philo)
+		{
+			free(env->grant_logs[i].tickets);
+			i++;
+		}
+	}
+	free(env->grant_logs);
+	free(env->grants);
+}
@@ -0,0 +1,176 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   init_alloc.c                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: imunaev- <imunaev-@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/03/19 15:08:33 by imunaev-          #+#    #+#             */
+/*   Updated: 2025/03/19 15:08:33 by imunaev-         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file init_alloc.c
+ * @brief Allocation of the optional simulation data structures.
+ *
+ * This file allocates the storage whose shape depends on run-time options:
+ * the fork table and the monitor shards with their deadline heaps. It also
+ * resets heap contents before a run.
+ */
+
+#include "philo.h"
+
+/**
+ * @brief Allocates the fork storage selected by `env->opts.fork_mode`.
+ *
+ * In mutex mode this is one `pthread_mutex_t` per fork. In bitmap mode it is
+ * one bit per fork, rounded up to whole 64-bit words, plus a waiter count
+ * per word. Both are carved from the arena, whose pages start zeroed, so
+ * the bitmap starts with every fork free.
+ *
+ * @param env Pointer to the environment structure.
+ * @return int Returns EXIT_SUCCESS if memory allocation is successful,
+ * otherwise returns EXIT_FAILURE.
+ */
+int	alloc_forks(t_env *env)
+{
+	t_fork_table	*t;
+
+	if (env->opts.fork_mode == FORK_MUTEX)
+	{
+		env->forks = arena_carve(&env->arena,
+				env->cfg.num_philo * sizeof(pthread_mutex_t));
+		return (env->forks == NULL);
+	}
+	t = &env->fork_table;
+	t->num_words = (env->cfg.num_philo + FORK_WORD_BITS - 1) / FORK_WORD_BITS;
+	t->words = arena_carve(&env->arena, t->num_words * sizeof(*t->words));
+	t->waiters = arena_carve(&env->arena,
+			t->num_words * sizeof(*t->waiters));
+	if (!t->words || !t->waiters)
+		return (EXIT_FAILURE);
+	return (EXIT_SUCCESS);
+}
+
+/**
+ * @brief Initializes the mutex and condition variable of the deadline heap.
+ *
+ * On failure the heap arrays are released and reset to NULL, so that a
+ * non-NULL `heap` always means the synchronization objects are valid.
+ *
+ * @param h Pointer to the deadline heap.
+ * @return int Returns EXIT_SUCCESS on success, otherwise EXIT_FAILURE.
+ */
+static int	init_heap_sync(t_deadline_heap *h)
+{
+	if (pthread_mutex_init(&h->mutex, NULL) == 0)
+	{
+		if (pthread_cond_init(&h->cond, NULL) == 0)
+			return (EXIT_SUCCESS);
+		(void)pthread_mutex_destroy(&h->mutex);
+	}
+	free(h->heap);
+	free(h->pos);
+	free(h->deadline);
+	h->heap = NULL;
+	h->pos = NULL;
+	h->deadline = NULL;
+	return (EXIT_FAILURE);
+}
+
+/**
+ * @brief Allocates a deadline heap covering `size` philosophers from `base`.
+ *
+ * The heap is filled with the real deadlines when the start gate opens.
+ *
+ * @param h Pointer to the deadline heap.
+ * @param base Index of the first philosopher covered by the heap.
+ * @param size Number of philosophers covered by the heap.
+ * @return int Returns EXIT_SUCCESS if memory allocation is successful,
+ * otherwise returns EXIT_FAILURE.
+ */
+int	alloc_heap(t_deadline_heap *h, int base, int size)
+{
+	h->base = base;
+	h->size = size;
+	h->heap = malloc(size * sizeof(int));
+	h->pos = malloc(size * sizeof(int));
+	h->deadline = malloc(size * sizeof(long));
+	if (!h->heap || !h->pos || !h->deadline)
+	{
+		free(h->heap);
+		free(h->pos);
+		free(h->deadline);
+		h->heap = NULL;
+		h->pos = NULL;
+		h->deadline = NULL;
+		return (EXIT_FAILURE);
+	}
+	return (init_heap_sync(h));
+}
+
+/**
+ * @brief Splits the philosophers into monitor shards.
+ *
+ * Each shard owns a contiguous range of `shard_size` philosophers (the last
+ * one may be shorter). The requested shard count is reduced when there are
+ * fewer philosophers than shards. In heap mode every shard gets its own
+ * deadline heap; in poll mode the shards share the scan kernel selected
+ * for this CPU.
+ *
+ * @param env Pointer to the environment structure.
+ * @return int Returns EXIT_SUCCESS if memory allocation is successful,
+ * otherwise returns EXIT_FAILURE.
+ */
+int	alloc_shards(t_env *env)
+{
+	int	i;
+
+	env->shard_size = (env->cfg.num_philo + env->opts.shards - 1)
+		/ env->opts.shards;
+	env->num_shards = (env->cfg.num_philo + env->shard_size - 1)
+		/ env->shard_size;
+	env->scan = select_scan();
+	env->shards = calloc(env->num_shards, sizeof(t_monitor_shard));
+	if (!env->shards)
+		return (EXIT_FAILURE);
+	i = 0;
+	while (i < env->num_shards)
+	{
+		env->shards[i].env = env;
+		env->shards[i].lo = i * env->shard_size;
+		env->shards[i].hi = (i + 1) * env->shard_size;
+		if (env->shards[i].hi > env->cfg.num_philo)
+			env->shards[i].hi = env->cfg.num_philo;
+		if (env->opts.monitor_mode == MONITOR_HEAP
+			&& alloc_heap(&env->shards[i].heap, env->shards[i].lo,
+				env->shards[i].hi - env->shards[i].lo) == EXIT_FAILURE)
+			return (EXIT_FAILURE);
+		i++;
+	}
+	return (EXIT_SUCCESS);
+}
+
+/**
+ * @brief Resets a heap so that every entry has the same key.
+ *
+ * Called while no other thread uses the heap. Equal keys in identity order
+ * already form a valid heap.
+ *
+ * @param h Pointer to the heap.
+ * @param key Key given to every entry.
+ */
+void	heap_fill(t_deadline_heap *h, long key)
+{
+	int	i;
+
+	i = 0;
+	while (i < h->size)
+	{
+		h->heap[i] = i;
+		h->pos[i] = i;
+		h->deadline[i] = key;
+		i++;
+	}
+}
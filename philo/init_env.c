@@ -21,49 +21,12 @@
 
 #include "philo.h"
 
-/**
- * @brief Initializes the philosopher structures.
- *
- * This function assigns initial values to each philosopher, including
- * ID, meal count, last meal time, and environmental settings.
- *
- * @param env Pointer to the environment structure.
- * @return int Returns EXIT_SUCCESS on success, or EXIT_FAILURE if the
- * start time retrieval fails.
- */
-static int	fillup_philos(t_env *env)
-{
-	int	i;
-
-	i = 0;
-	env->start_time = get_time();
-	if (env->start_time == -1)
-	{
-		print_error("Error: fillup_philos: get_time failed.\n");
-		return (EXIT_FAILURE);
-	}
-	while (i < env->num_philo)
-	{
-		env->philos[i].id = i;
-		env->philos[i].meals = 0;
-		env->philos[i].last_meal = env->start_time;
-		env->philos[i].last_meal = 0;
-		env->philos[i].env = env;
-		env->philos[i].num_philo = env->num_philo;
-		env->philos[i].die_time = env->die_time;
-		env->philos[i].eat_time = env->eat_time;
-		env->philos[i].sleep_time = env->sleep_time;
-		env->philos[i].meals_limit = env->meals_limit;
-		i++;
-	}
-	return (EXIT_SUCCESS);
-}
-
 /**
  * @brief Initializes all required mutexes for thread synchronization.
  *
  * This function initializes mutexes used for printing, meal tracking,
- * thread synchronization, and philosopher fork control.
+ * end-of-simulation signalling, and logging. The fork mutexes are
+ * initialized together with the philosophers by `init_philos_forks()`.
  *
  * @param env Pointer to the environment structure.
  * @return int Returns EXIT_SUCCESS if all mutexes are initialized successfully,
@@ -75,23 +38,78 @@ static int	init_mutexes(t_env *env)
 		return (EXIT_FAILURE);
 	if (init_meal_mutex(env) == EXIT_FAILURE)
 		return (EXIT_FAILURE);
-	if (init_start_mutex(env) == EXIT_FAILURE)
-		return (EXIT_FAILURE);
 	if (init_end_mutex(env) == EXIT_FAILURE)
 		return (EXIT_FAILURE);
-	if (init_forks_mutex(env) == EXIT_FAILURE)
-		return (EXIT_FAILURE);
 	if (init_log_buffer_mutex(env) == EXIT_FAILURE)
 		return (EXIT_FAILURE);
 	return (EXIT_SUCCESS);
 }
 
+/**
+ * @brief Resets run-time state and resource pointers of the environment.
+ *
+ * Every pointer is set to NULL first, so that cleanup after a partial
+ * initialization only frees what was actually allocated.
+ *
+ * @param env Pointer to the environment structure.
+ */
+static void	reset_state(t_env *env)
+{
+	env->ended = 0;
+	env->start_time = 0;
+	env->log_buffer.count = 0;
+	env->t_philos_created = false;
+	env->t_logger_created = false;
+	atomic_init(&env->ready_count, 0);
+	atomic_init(&env->start_gate, 0);
+	atomic_init(&env->satiated, 0);
+	env->scenario = NULL;
+	env->philos = NULL;
+	env->forks = NULL;
+	env->pool = NULL;
+	env->coro = NULL;
+	env->start_expected = env->cfg.num_philo;
+	env->shards = NULL;
+	env->num_shards = 0;
+	env->death_latency = -1;
+	env->num_spawners = 0;
+	env->spawn_us = 0;
+	env->fork_node = NULL;
+	env->topo.num_cpus = 0;
+	env->topo.num_nodes = 0;
+	atomic_init(&env->handoffs, 0);
+	atomic_init(&env->cross_handoffs, 0);
+}
+
+/**
+ * @brief Sets up the optional instruments: `--lockstat`, `--live`,
+ * `--trace` and `--record` or `--replay`.
+ *
+ * @param env Pointer to the environment structure.
+ * @return int Returns EXIT_SUCCESS if every enabled instrument is ready,
+ * otherwise EXIT_FAILURE.
+ */
+static int	alloc_tools(t_env *env)
+{
+	if (alloc_lockstat(env) == EXIT_FAILURE
+		|| alloc_live(env) == EXIT_FAILURE
+		|| alloc_trace(env) == EXIT_FAILURE
+		|| alloc_grants(env) == EXIT_FAILURE)
+		return (EXIT_FAILURE);
+	return (EXIT_SUCCESS);
+}
+
 /**
  * @brief Allocates memory for philosopher and fork structures.
  *
- * This function dynamically allocates memory for the philosopher
- * array (`env->philos`) and the fork mutex array (`env->forks`). If
- * allocation fails, it prints an error message and ensures proper cleanup.
+ * This function carves the philosopher array (`env->philos`), the hot
+ * `last_meal`, `deadline` and `meals` arrays, the latency histograms of
+ * `--report` and the forks (`env->forks` or
+ * `env->fork_table`) from the arena and allocates
+ * the monitor shards with their deadline heaps and, with the pool or
+ * coroutine engine, the worker pool or the coroutines, followed by the
+ * enabled instruments (see `alloc_tools()`). If allocation fails,
+ * it prints an error message and ensures proper cleanup.
  *
  * @param env Pointer to the environment structure.
  * @return int Returns EXIT_SUCCESS if memory allocation is successful,
@@ -99,18 +117,28 @@ static int	init_mutexes(t_env *env)
  */
 static int	init_forks_philos(t_env *env)
 {
-	env->forks = malloc(env->num_philo * sizeof(pthread_mutex_t));
-	if (!env->forks)
+	int	n;
+
+	n = env->cfg.num_philo;
+	env->philos = arena_carve(&env->arena, n * sizeof(t_philo));
+	env->last_meal = arena_carve(&env->arena, n * sizeof(long));
+	env->deadline = arena_carve(&env->arena, n * sizeof(long));
+	env->meals = arena_carve(&env->arena, n * sizeof(int));
+	if (env->opts.report)
+		env->lat = arena_carve(&env->arena, n * sizeof(t_latency));
+	if (!env->philos || !env->last_meal || !env->deadline || !env->meals
+		|| (env->opts.report && !env->lat)
+		|| alloc_forks(env) == EXIT_FAILURE)
 	{
-		print_error ("Error: init_forks_philos: forks mem alloc failed.\n");
+		print_error ("Error: init_forks_philos: philos mem alloc failed.\n");
 		return (EXIT_FAILURE);
 	}
-	env->philos = malloc(env->num_philo * sizeof(t_philo));
-	if (!env->philos)
+	if (alloc_shards(env) == EXIT_FAILURE || alloc_pool(env) == EXIT_FAILURE
+		|| alloc_coro(env) == EXIT_FAILURE
+		|| alloc_tools(env) == EXIT_FAILURE
+		|| alloc_placement(env) == EXIT_FAILURE)
 	{
-		print_error ("Error: init_forks_philos: philos mem alloc failed.\n");
-		free(env->forks);
-		env->forks = NULL;
+		print_error ("Error: init_forks_philos: threads alloc failed.\n");
 		return (EXIT_FAILURE);
 	}
 	return (EXIT_SUCCESS);
@@ -120,8 +148,11 @@ static int	init_forks_philos(t_env *env)
  * @brief Initializes the simulation environment.
  *
  * This function parses input arguments, sets up philosopher count,
- * timing values, and meal limits. It then allocates necessary
- * resources, initializes mutexes, and configures philosophers.
+ * timing values, and meal limits, and loads the `--scenario` rules that
+ * override them per philosopher. It then allocates necessary
+ * resources, initializes mutexes, and configures philosophers and their
+ * forks in parallel slices. Finally the whole arena is prefaulted so the
+ * simulation does not take page faults on it.
  *
  * If any step fails, it ensures proper cleanup and returns an error.
  *
@@ -133,29 +164,24 @@ static int	init_forks_philos(t_env *env)
  */
 int	init_env(t_env *env, int ac, char **av)
 {
-	env->num_philo = ft_atoi(av[1]);
-	env->die_time = ft_atoi(av[2]);
-	env->eat_time = ft_atoi(av[3]);
-	env->sleep_time = ft_atoi(av[4]);
-	env->meals_limit = -1;
+	env->launch_time = get_time();
+	env->cfg.num_philo = ft_atoi(av[1]);
+	env->cfg.die_time = ft_atoi(av[2]);
+	env->cfg.eat_time = ft_atoi(av[3]);
+	env->cfg.sleep_time = ft_atoi(av[4]);
+	env->cfg.meals_limit = -1;
 	if (ac == 6)
-		env->meals_limit = ft_atoi(av[5]);
-	env->ended = 0;
-	env->start_time = 0;
-	env->log_buffer.count = 0;
-	env->t_philos_created = false;
-	env->t_logger_created = false;
-	env->t_mon_created = false;
-	env->philos = NULL;
-	env->forks = NULL;
+		env->cfg.meals_limit = ft_atoi(av[5]);
+	reset_state(env);
+	if (load_scenario(env) == EXIT_FAILURE)
+		return (EXIT_FAILURE);
 	if (init_forks_philos(env) == EXIT_FAILURE)
 		return (EXIT_FAILURE);
 	if (init_mutexes(env) == EXIT_FAILURE)
 		return (EXIT_FAILURE);
-	if (fillup_philos(env) == EXIT_FAILURE)
-	{
-		destroy_mutexes(env);
+	if (init_philos_forks(env) == EXIT_FAILURE)
 		return (EXIT_FAILURE);
-	}
+	scenario_limits(env);
+	arena_prefault(&env->arena);
 	return (EXIT_SUCCESS);
 }
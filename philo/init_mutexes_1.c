@@ -15,34 +15,12 @@
  * @brief Mutex initialization functions for the philosopher simulation.
  *
  * This file contains functions for initializing mutexes used for
- * synchronization in the simulation, including control over start,
- * end conditions, logging, and philosopher fork access.
+ * synchronization in the simulation, including control over end
+ * conditions, logging, and philosopher fork access.
  */
 
 #include "philo.h"
 
-/**
- * @brief Initializes the start synchronization mutex.
- *
- * This mutex ensures that all philosophers start at the same time.
- * If initialization fails, it destroys previously initialized mutexes
- * (`print_mutex` and `meal_mutex`) to prevent resource leaks.
- *
- * @param env Pointer to the environment structure.
- * @return int Returns EXIT_SUCCESS on success, or EXIT_FAILURE if
- * initialization fails.
- */
-int	init_start_mutex(t_env *env)
-{
-	if (pthread_mutex_init(&env->start_mutex, NULL) != 0)
-	{
-		(void)pthread_mutex_destroy(&env->print_mutex);
-		(void)pthread_mutex_destroy(&env->meal_mutex);
-		return (EXIT_FAILURE);
-	}
-	return (EXIT_SUCCESS);
-}
-
 /**
  * @brief Initializes the end synchronization mutex.
  *
@@ -60,7 +38,6 @@ int	init_end_mutex(t_env *env)
 	{
 		(void)pthread_mutex_destroy(&env->print_mutex);
 		(void)pthread_mutex_destroy(&env->meal_mutex);
-		(void)pthread_mutex_destroy(&env->start_mutex);
 		return (EXIT_FAILURE);
 	}
 	return (EXIT_SUCCESS);
@@ -84,7 +61,6 @@ int	init_log_buffer_mutex(t_env *env)
 	{
 		(void)pthread_mutex_destroy(&env->print_mutex);
 		(void)pthread_mutex_destroy(&env->meal_mutex);
-		(void)pthread_mutex_destroy(&env->start_mutex);
 		(void)pthread_mutex_destroy(&env->end_mutex);
 		return (EXIT_FAILURE);
 	}
@@ -92,37 +68,36 @@ int	init_log_buffer_mutex(t_env *env)
 }
 
 /**
- * @brief Initializes mutexes for philosopher forks.
+ * @brief Initializes the fork mutexes of philosophers `lo` to `hi - 1`.
  *
  * Each philosopher has a corresponding fork mutex to control access
- * to shared resources. If initialization fails, previously initialized
- * fork mutexes are destroyed to prevent resource leaks. Additionally,
- * all other environment-related mutexes are also destroyed to ensure
- * a complete cleanup.
+ * to shared resources. Slices of the fork array are initialized in
+ * parallel at startup (see `init_philos_forks()`). If initialization
+ * fails, the fork mutexes already initialized in this slice are destroyed
+ * to prevent resource leaks; the caller cleans up the other slices and
+ * the environment mutexes. Nothing is done when forks live in the fork
+ * bitmap.
  *
  * @param env Pointer to the environment structure.
+ * @param lo First fork of the slice.
+ * @param hi End of the slice.
  * @return int Returns EXIT_SUCCESS if all fork mutexes are initialized,
  * otherwise returns EXIT_FAILURE.
  */
-int	init_forks_mutex(t_env *env)
+int	init_forks_mutex(t_env *env, int lo, int hi)
 {
 	int	i;
 
-	i = 0;
-	while (i < env->num_philo)
+	i = lo;
+	while (env->forks && i < hi)
 	{
 		if (pthread_mutex_init(&env->forks[i], NULL) != 0)
 		{
-			while (i > 0)
+			while (i > lo)
 			{
 				i--;
 				(void)pthread_mutex_destroy(&env->forks[i]);
 			}
-			(void)pthread_mutex_destroy(&env->print_mutex);
-			(void)pthread_mutex_destroy(&env->meal_mutex);
-			(void)pthread_mutex_destroy(&env->start_mutex);
-			(void)pthread_mutex_destroy(&env->end_mutex);
-			(void)pthread_mutex_destroy(&env->log_buffer.mutex);
 			return (EXIT_FAILURE);
 		}
 		i++;
@@ -24,26 +24,32 @@
 /**
  * @brief Allocates and initializes the program environment.
  *
- * This function dynamically allocates memory for the environment (`t_env`)
- * and initializes all required parameters, including mutexes, philosopher
- * structures, and simulation settings.
+ * This function maps the arena sized for the philosopher count, carves the
+ * environment (`t_env`) from its start and initializes all required
+ * parameters, including mutexes, philosopher structures, and simulation
+ * settings.
  *
- * If memory allocation fails, the program prints an error message and
+ * If the mapping fails, the program prints an error message and
  * immediately exits with EXIT_FAILURE. If environment initialization fails,
  * it frees allocated resources before exiting.
  *
  * @param env Pointer to the environment structure pointer (`t_env **`).
+ * @param opts Run-time options parsed from the command line.
  * @param ac Argument count from the command-line input.
  * @param av Argument vector containing simulation parameters.
  */
-void	init_program(t_env **env, int ac, char **av)
+void	init_program(t_env **env, t_opts *opts, int ac, char **av)
 {
-	*env = malloc(sizeof(t_env));
-	if (!*env)
+	t_arena	arena;
+
+	if (arena_map(&arena, opts, ft_atoi(av[1])) == EXIT_FAILURE)
 	{
 		print_error("Error: init_and_setup: env mem alloc failed\n");
 		exit (EXIT_FAILURE);
 	}
+	*env = arena_carve(&arena, sizeof(t_env));
+	(*env)->arena = arena;
+	(*env)->opts = *opts;
 	if (init_env(*env, ac, av) == EXIT_FAILURE)
 	{
 		free_env(*env);
@@ -0,0 +1,140 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   init_slices.c                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: imunaev- <imunaev-@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/03/25 10:37:52 by imunaev-          #+#    #+#             */
+/*   Updated: 2025/03/25 10:37:52 by imunaev-         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file init_slices.c
+ * @brief Parallel initialization of philosophers and fork mutexes.
+ *
+ * Each slice of philosophers and forks is initialized by its own spawner
+ * thread. That thread is also the first to write the slice, so with
+ * `--placement=numa` the pages are faulted in on the slice's node.
+ */
+
+#include "philo.h"
+
+/**
+ * @brief Initializes the philosopher structures `lo` to `hi - 1`.
+ *
+ * This function assigns initial values to each philosopher, including
+ * ID, meal count, and its timings and meal limit: those of the command
+ * line, overridden by the `--scenario` rules. A philosopher with a meal
+ * limit of 0 is satiated from the start. Writing the slice's entries of
+ * the hot arrays here also first-touches them from the spawner serving the
+ * slice. The start time, the initial last meal time and the deadlines are
+ * set later, when the start gate opens.
+ *
+ * @param env Pointer to the environment structure.
+ * @param lo First philosopher of the slice.
+ * @param hi End of the slice.
+ */
+static void	fillup_philos(t_env *env, int lo, int hi)
+{
+	t_philo	*p;
+
+	while (lo < hi)
+	{
+		p = &env->philos[lo];
+		p->id = lo;
+		env->meals[lo] = 0;
+		env->last_meal[lo] = 0;
+		p->first_meal = 0;
+		p->start_lag = 0;
+		p->env = env;
+		p->die_time = env->cfg.die_time;
+		p->eat_time = env->cfg.eat_time;
+		p->sleep_time = env->cfg.sleep_time;
+		p->meals_limit = env->cfg.meals_limit;
+		if (env->scenario)
+			apply_scenario(env, p);
+		if (p->meals_limit == 0)
+			atomic_fetch_add(&env->satiated, 1);
+		p->waiting = false;
+		p->coro = NULL;
+		if (env->coro)
+			p->coro = &env->coro->coros[lo];
+		lo++;
+	}
+}
+
+/**
+ * @brief Spawner function initializing one slice of forks and philosophers.
+ *
+ * @param arg Pointer to the slice (`t_spawner`).
+ * @return NULL when the slice is done.
+ */
+static void	*init_slice(void *arg)
+{
+	t_spawner	*sp;
+
+	sp = (t_spawner *)arg;
+	sp->status = init_forks_mutex(sp->env, sp->lo, sp->hi);
+	if (sp->status == EXIT_SUCCESS)
+	{
+		fillup_philos(sp->env, sp->lo, sp->hi);
+		live_timings(sp->env, sp->lo, sp->hi);
+		sp->done = sp->hi - sp->lo;
+	}
+	return (NULL);
+}
+
+/**
+ * @brief Destroys the environment mutexes and the fork mutexes of every
+ * slice that was initialized.
+ *
+ * @param env Pointer to the environment structure.
+ * @param sp The slices.
+ * @param n Number of slices.
+ */
+static void	undo_slices(t_env *env, t_spawner *sp, int n)
+{
+	int	i;
+	int	k;
+
+	k = 0;
+	while (k < n)
+	{
+		i = sp[k].lo;
+		while (env->forks && i < sp[k].lo + sp[k].done)
+		{
+			(void)pthread_mutex_destroy(&env->forks[i]);
+			i++;
+		}
+		k++;
+	}
+	(void)pthread_mutex_destroy(&env->print_mutex);
+	(void)pthread_mutex_destroy(&env->meal_mutex);
+	(void)pthread_mutex_destroy(&env->end_mutex);
+	(void)pthread_mutex_destroy(&env->log_buffer.mutex);
+}
+
+/**
+ * @brief Initializes the fork mutexes and the philosophers in parallel.
+ *
+ * If any fork mutex fails to initialize, every mutex initialized so far is
+ * destroyed, including the environment mutexes.
+ *
+ * @param env Pointer to the environment structure.
+ * @return int Returns EXIT_SUCCESS if every slice was initialized,
+ * otherwise returns EXIT_FAILURE.
+ */
+int	init_philos_forks(t_env *env)
+{
+	t_spawner	sp[MAX_SPAWNERS];
+	int			n;
+
+	n = run_spawners(env, sp, init_slice);
+	if (!spawners_failed(sp, n))
+		return (EXIT_SUCCESS);
+	print_error("Error: init_philos_forks: fork mutex init failed.\n");
+	undo_slices(env, sp, n);
+	return (EXIT_FAILURE);
+}
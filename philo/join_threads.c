@@ -14,13 +14,35 @@
  * @file join_threads.c
  * @brief Thread management for the philosopher simulation.
  *
- * This file contains the function responsible for joining all created
- * threads, ensuring proper synchronization and cleanup before exiting
- * the program.
+ * This file contains the functions responsible for joining all created
+ * threads, or waiting for the crew of a `--batch` run, ensuring proper
+ * synchronization and cleanup before exiting the program.
  */
 
 #include "philo.h"
 
+/**
+ * @brief Waits until every crew member the run used has parked again.
+ *
+ * This is the crew counterpart of joining the run's threads; afterwards
+ * the members can be handed the next run's tasks.
+ *
+ * @param c The crew.
+ */
+void	crew_wait(t_crew *c)
+{
+	int	i;
+
+	i = 0;
+	while (i < c->used)
+	{
+		while (atomic_load(&c->members[i].state) == CREW_BUSY)
+			futex_wait(&c->members[i].state, CREW_BUSY);
+		i++;
+	}
+	c->used = 0;
+}
+
 /**
  * @brief Waits for all created threads to finish execution.
  *
@@ -29,30 +51,38 @@
  * and ensuring safe resource cleanup.
  *
  * - If philosopher threads were created, it joins each philosopher thread.
- * - If the monitor thread was created, it joins the monitor thread.
+ * - It joins every pool worker, coroutine carrier and monitor shard thread
+ *   that was created.
  * - If the logger thread was created, it joins the logger thread.
+ * - In a `--batch` run, which starts no logger, it waits for the crew
+ *   instead (see `crew_wait()`).
  *
  * @param env Pointer to the environment structure (`t_env`).
- * @param mon Monitor thread identifier.
  * @param logger_thread Logger thread identifier.
  */
-void	join_threads(t_env *env, pthread_t mon, pthread_t logger_thread)
+void	join_threads(t_env *env, pthread_t logger_thread)
 {
 	int	i;
 
 	if (!env)
 		return ;
+	if (env->crew)
+	{
+		crew_wait(env->crew);
+		return ;
+	}
 	if (env->t_philos_created)
 	{
 		i = 0;
-		while (i < env->num_philo)
+		while (i < env->cfg.num_philo)
 		{
 			pthread_join(env->philos[i].thread, NULL);
 			i++;
 		}
 	}
-	if (env->t_mon_created)
-		pthread_join(mon, NULL);
+	join_pool_workers(env);
+	join_coro_carriers(env);
+	join_monitor_threads(env);
 	if (env->t_logger_created)
 		pthread_join(logger_thread, NULL);
 }
@@ -0,0 +1,129 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   latency.c                                          :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: imunaev- <imunaev-@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/03/27 14:12:09 by imunaev-          #+#    #+#             */
+/*   Updated: 2025/03/27 14:12:09 by imunaev-         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file latency.c
+ * @brief Recording of the per-philosopher latency histograms.
+ *
+ * With `--report`, every meal start adds the fork wait, the interval since
+ * the previous meal and the remaining starvation margin to the
+ * philosopher's own histograms. Without it `env->lat` is NULL and the
+ * hooks return at once.
+ */
+
+#include "philo.h"
+
+/**
+ * @brief Returns the histogram bucket of `v`.
+ *
+ * The bucket is made of the bit length of `v` and the `HIST_SUB_BITS` bits
+ * that follow its leading one.
+ *
+ * @param v Value in microseconds.
+ * @return int Index of the bucket.
+ */
+static int	hist_bucket(long v)
+{
+	int	shift;
+	int	b;
+
+	if (v <= 0)
+		return (0);
+	if (v < (1L << HIST_SUB_BITS))
+		return (v);
+	shift = 63 - __builtin_clzl((unsigned long)v) - HIST_SUB_BITS;
+	b = ((shift + 1) << HIST_SUB_BITS) + (int)(v >> shift)
+		- (1 << HIST_SUB_BITS);
+	if (b >= HIST_BUCKETS)
+		return (HIST_BUCKETS - 1);
+	return (b);
+}
+
+/**
+ * @brief Returns the largest value that falls in bucket `b`.
+ *
+ * @param b Index of the bucket.
+ * @return long The upper bound of the bucket, in microseconds.
+ */
+long	hist_upper(int b)
+{
+	long	lead;
+	int		shift;
+
+	if (b < (1 << HIST_SUB_BITS))
+		return (b);
+	shift = (b >> HIST_SUB_BITS) - 1;
+	lead = (b & ((1 << HIST_SUB_BITS) - 1)) + (1 << HIST_SUB_BITS);
+	return (((lead + 1) << shift) - 1);
+}
+
+/**
+ * @brief Adds one value to a histogram.
+ *
+ * @param h Pointer to the histogram.
+ * @param v Value in microseconds.
+ */
+static void	hist_add(t_hist *h, long v)
+{
+	h->counts[hist_bucket(v)]++;
+	if (h->n == 0 || v < h->min)
+		h->min = v;
+	if (h->n == 0 || v > h->max)
+		h->max = v;
+	h->n++;
+}
+
+/**
+ * @brief Notes that the philosopher starts waiting for its forks.
+ *
+ * @param p Pointer to the philosopher structure.
+ */
+void	latency_hungry(t_philo *p)
+{
+	if (!p->env->lat)
+		return ;
+	p->env->lat[p->id].hungry_at = get_time_us();
+}
+
+/**
+ * @brief Records a meal start: fork wait, meal interval and margin.
+ *
+ * Called once the philosopher holds both forks. The margin is its own
+ * `die_time` minus the time since the previous meal started, and goes
+ * negative if the philosopher ate after its deadline; such a margin is
+ * recorded, negated, in `overshoot`.
+ *
+ * @param p Pointer to the philosopher structure.
+ */
+void	latency_meal(t_philo *p)
+{
+	t_latency	*l;
+	long		now;
+	long		since;
+	long		margin;
+
+	if (!p->env->lat)
+		return ;
+	l = &p->env->lat[p->id];
+	now = get_time_us();
+	since = l->meal_at;
+	if (since == 0)
+		since = p->env->start_time * 1000;
+	hist_add(&l->wait, now - l->hungry_at);
+	hist_add(&l->interval, now - since);
+	margin = p->die_time * 1000 - (now - since);
+	if (margin < 0)
+		hist_add(&l->overshoot, -margin);
+	else
+		hist_add(&l->margin, margin);
+	l->meal_at = now;
+}
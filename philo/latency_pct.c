@@ -0,0 +1,114 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   latency_pct.c                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: imunaev- <imunaev-@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 19:12:07 by imunaev-          #+#    #+#             */
+/*   Updated: 2026/10/19 19:12:07 by imunaev-         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file latency_pct.c
+ * @brief Percentiles of the latency histograms.
+ *
+ * Percentiles are read from the log buckets, so they are bounds at most a
+ * quarter away from the true value, on the pessimistic side, clipped to
+ * the exact minimum and maximum. The starvation margin is signed: its
+ * negative values are kept as overshoots in a histogram of their own.
+ */
+
+#include "philo.h"
+
+/**
+ * @brief Returns the `rank`-th smallest value of a histogram.
+ *
+ * @param h Pointer to the histogram (must not be empty).
+ * @param rank Rank from 1 to `h->n`.
+ * @return long The upper bound of the bucket holding that rank.
+ */
+static long	hist_rank(const t_hist *h, long rank)
+{
+	long	seen;
+	long	v;
+	int		b;
+
+	seen = 0;
+	b = 0;
+	while (b < HIST_BUCKETS - 1 && seen + h->counts[b] < rank)
+	{
+		seen += h->counts[b];
+		b++;
+	}
+	v = hist_upper(b);
+	if (b == HIST_BUCKETS - 1 || v > h->max)
+		v = h->max;
+	if (v < h->min)
+		v = h->min;
+	return (v);
+}
+
+/**
+ * @brief Returns the rank of the `permille`-th per-mille of `n` values.
+ *
+ * @param n Number of values.
+ * @param permille Rank in thousandths (500 for the median).
+ * @return long The rank, from 1 to `n`.
+ */
+static long	pct_rank(long n, long permille)
+{
+	long	rank;
+
+	rank = (n * permille + 999) / 1000;
+	if (rank < 1)
+		rank = 1;
+	return (rank);
+}
+
+/**
+ * @brief Estimates the `permille`-th per-mille value of a histogram.
+ *
+ * @param h Pointer to the histogram (must not be empty).
+ * @param permille Rank in thousandths (500 for the median).
+ * @return long The upper bound of the bucket holding that rank.
+ */
+long	hist_pct(const t_hist *h, long permille)
+{
+	return (hist_rank(h, pct_rank(h->n, permille)));
+}
+
+/**
+ * @brief Returns the smallest starvation margin, negative if the
+ * philosopher ever ate after its deadline.
+ *
+ * @param l Pointer to the histograms (with at least one meal).
+ * @return long The exact minimum in microseconds.
+ */
+long	margin_min(const t_latency *l)
+{
+	if (l->overshoot.n > 0)
+		return (-l->overshoot.max);
+	return (l->margin.min);
+}
+
+/**
+ * @brief Estimates the `permille`-th per-mille starvation margin.
+ *
+ * The overshoots are the lowest margins: a rank among them counts from
+ * their largest one down, and is reported negated.
+ *
+ * @param l Pointer to the histograms (with at least one meal).
+ * @param permille Rank in thousandths (10 for p1).
+ * @return long The margin in microseconds.
+ */
+long	margin_pct(const t_latency *l, long permille)
+{
+	long	rank;
+
+	rank = pct_rank(l->margin.n + l->overshoot.n, permille);
+	if (rank <= l->overshoot.n)
+		return (-hist_rank(&l->overshoot, l->overshoot.n - rank + 1));
+	return (hist_rank(&l->margin, rank - l->overshoot.n));
+}
@@ -0,0 +1,136 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   latency_report.c                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: imunaev- <imunaev-@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/03/27 14:48:31 by imunaev-          #+#    #+#             */
+/*   Updated: 2025/03/27 14:48:31 by imunaev-         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file latency_report.c
+ * @brief Aggregation and printing of the latency histograms.
+ *
+ * The percentiles themselves are read in `latency_pct.c`.
+ */
+
+#include "philo.h"
+
+/**
+ * @brief Adds the counts of `src` to `dst`.
+ *
+ * @param dst Pointer to the aggregate histogram.
+ * @param src Pointer to one philosopher's histogram.
+ */
+static void	hist_merge(t_hist *dst, const t_hist *src)
+{
+	int	b;
+
+	if (src->n == 0)
+		return ;
+	b = 0;
+	while (b < HIST_BUCKETS)
+	{
+		dst->counts[b] += src->counts[b];
+		b++;
+	}
+	if (dst->n == 0 || src->min < dst->min)
+		dst->min = src->min;
+	if (dst->n == 0 || src->max > dst->max)
+		dst->max = src->max;
+	dst->n += src->n;
+}
+
+/**
+ * @brief Adds the histograms of one philosopher to the table's.
+ *
+ * @param dst Pointer to the table's histograms.
+ * @param src Pointer to one philosopher's histograms.
+ */
+static void	merge_latency(t_latency *dst, const t_latency *src)
+{
+	hist_merge(&dst->wait, &src->wait);
+	hist_merge(&dst->interval, &src->interval);
+	hist_merge(&dst->margin, &src->margin);
+	hist_merge(&dst->overshoot, &src->overshoot);
+}
+
+/**
+ * @brief Prints one row: fork wait and meal interval as p50/p99/max, and
+ * the starvation margin as min/p1/p50, since its low end is the risk.
+ *
+ * @param who Label of the row.
+ * @param l Pointer to the histograms.
+ */
+static void	print_row(const char *who, const t_latency *l)
+{
+	if (l->wait.n == 0)
+		return ;
+	fprintf(stderr, "latency %-9s wait %ld/%ld/%ld, interval %ld/%ld/%ld, "
+		"margin %ld/%ld/%ld us\n", who,
+		hist_pct(&l->wait, 500), hist_pct(&l->wait, 990), l->wait.max,
+		hist_pct(&l->interval, 500), hist_pct(&l->interval, 990),
+		l->interval.max, margin_min(l), margin_pct(l, 10),
+		margin_pct(l, 500));
+}
+
+/**
+ * @brief Returns the philosopher whose margin came lowest.
+ *
+ * @param env Pointer to the environment structure.
+ * @return int Index of that philosopher, or -1 if nobody ate.
+ */
+static int	closest_call(t_env *env)
+{
+	int	worst;
+	int	i;
+
+	worst = -1;
+	i = 0;
+	while (i < env->cfg.num_philo)
+	{
+		if (env->lat[i].wait.n > 0 && (worst < 0
+				|| margin_min(&env->lat[i]) < margin_min(&env->lat[worst])))
+			worst = i;
+		i++;
+	}
+	return (worst);
+}
+
+/**
+ * @brief Reports the latency histograms per philosopher and for the table.
+ *
+ * Every philosopher gets a row when there are at most `LATENCY_ROWS` of
+ * them; otherwise only the one that came closest to starving does.
+ *
+ * @param env Pointer to the environment structure.
+ */
+void	report_latency(t_env *env)
+{
+	t_latency	total;
+	char		who[24];
+	int			worst;
+	int			i;
+
+	if (!env->lat)
+		return ;
+	worst = closest_call(env);
+	if (worst < 0)
+		return ;
+	fprintf(stderr, "latency (wait, interval: p50/p99/max; "
+		"margin: min/p1/p50):\n");
+	memset(&total, 0, sizeof(total));
+	i = 0;
+	while (i < env->cfg.num_philo)
+	{
+		merge_latency(&total, &env->lat[i]);
+		snprintf(who, sizeof(who), "philo %d", i + 1);
+		if (env->cfg.num_philo <= LATENCY_ROWS || i == worst)
+			print_row(who, &env->lat[i]);
+		i++;
+	}
+	print_row("table", &total);
+}
@@ -0,0 +1,120 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   live.c                                             :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: imunaev- <imunaev-@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/03/28 15:37:02 by imunaev-          #+#    #+#             */
+/*   Updated: 2025/03/28 15:37:02 by imunaev-         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file live.c
+ * @brief Setup and teardown of the `--live` shared memory segment.
+ *
+ * The segment is `/dev/shm/philo.<pid>`: a `t_live_header` followed by one
+ * `t_live_slot` per philosopher. All system calls happen here, before the
+ * simulation starts and after it ended; during the run the segment is only
+ * written through plain stores (see `live_publish()`), and `philo-top`
+ * maps it read-only.
+ */
+
+#include "philo.h"
+#include <fcntl.h>
+#include <sys/mman.h>
+
+/**
+ * @brief Fills the header of a freshly mapped segment.
+ *
+ * @param env Pointer to the environment structure.
+ */
+static void	live_header(t_env *env)
+{
+	t_live_header	*h;
+
+	h = env->live;
+	h->num_philo = env->cfg.num_philo;
+	h->die_time = env->cfg.die_time;
+	h->eat_time = env->cfg.eat_time;
+	h->sleep_time = env->cfg.sleep_time;
+	h->meals_limit = env->cfg.meals_limit;
+	h->fork_stats = (env->fork_stats != NULL);
+	env->live_slots = (t_live_slot *)((char *)h
+			+ (sizeof(t_live_header) + CACHE_LINE - 1) / CACHE_LINE
+			* CACHE_LINE);
+	h->magic = LIVE_MAGIC;
+}
+
+/**
+ * @brief Creates the segment `env->live_name` of `env->live_size` bytes
+ * and maps it.
+ *
+ * @param env Pointer to the environment structure.
+ * @return void* The mapping, or MAP_FAILED.
+ */
+static void	*live_map(t_env *env)
+{
+	void	*map;
+	int		fd;
+
+	fd = shm_open(env->live_name, O_CREAT | O_EXCL | O_RDWR, 0644);
+	if (fd < 0)
+		return (MAP_FAILED);
+	map = MAP_FAILED;
+	if (ftruncate(fd, env->live_size) == 0)
+		map = mmap(NULL, env->live_size, PROT_READ | PROT_WRITE,
+				MAP_SHARED, fd, 0);
+	close(fd);
+	if (map == MAP_FAILED)
+		shm_unlink(env->live_name);
+	return (map);
+}
+
+/**
+ * @brief Creates and maps the segment when `--live` is given.
+ *
+ * Prints the `philo-top` command that watches the run to stderr.
+ *
+ * @param env Pointer to the environment structure.
+ * @return int Returns EXIT_SUCCESS on success, otherwise EXIT_FAILURE.
+ */
+int	alloc_live(t_env *env)
+{
+	void	*map;
+
+	if (!env->opts.live)
+		return (EXIT_SUCCESS);
+	snprintf(env->live_name, sizeof(env->live_name), "%s%d", LIVE_PREFIX,
+		(int)getpid());
+	env->live_size = (sizeof(t_live_header) + CACHE_LINE - 1) / CACHE_LINE
+		* CACHE_LINE + env->cfg.num_philo * sizeof(t_live_slot);
+	map = live_map(env);
+	if (map == MAP_FAILED)
+	{
+		print_error("Error: alloc_live: cannot create the segment\n");
+		return (EXIT_FAILURE);
+	}
+	env->live = map;
+	live_header(env);
+	fprintf(stderr, "live stats: ./philo-top %d\n", (int)getpid());
+	return (EXIT_SUCCESS);
+}
+
+/**
+ * @brief Marks the run as ended, then unmaps and removes the segment.
+ *
+ * A `philo-top` that already mapped the segment keeps the final state.
+ *
+ * @param env Pointer to the environment structure.
+ */
+void	free_live(t_env *env)
+{
+	if (!env->live)
+		return ;
+	atomic_store(&env->live->ended, 1);
+	(void)munmap(env->live, env->live_size);
+	(void)shm_unlink(env->live_name);
+	env->live = NULL;
+}
@@ -0,0 +1,112 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   live_publish.c                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: imunaev- <imunaev-@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/03/28 16:02:51 by imunaev-          #+#    #+#             */
+/*   Updated: 2025/03/28 16:02:51 by imunaev-         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file live_publish.c
+ * @brief Publishing of philosopher snapshots to the `--live` segment.
+ */
+
+#include "philo.h"
+
+/**
+ * @brief Maps a status message to the state it starts.
+ *
+ * @param status Status message of the philosopher.
+ * @return int The `t_live_state`, or -1 for an unknown message.
+ */
+static int	live_state(const char *status)
+{
+	static const char *const	names[] = {"has taken a fork", "is eating",
+		"is sleeping", "is thinking", NULL};
+	int							i;
+
+	i = 0;
+	while (names[i] && ft_strncmp(status, names[i], 32) != 0)
+		i++;
+	if (!names[i])
+		return (-1);
+	return (LIVE_FORK + i);
+}
+
+/**
+ * @brief Publishes the philosopher's new state in its seqlocked slot.
+ *
+ * The sequence number is made odd before the fields are written and even
+ * again after, with release ordering, so that `philo-top` never keeps a
+ * torn copy. No system call is made.
+ *
+ * Thread safety:
+ * - Only the philosopher itself writes its slot.
+ *
+ * @param p Pointer to the philosopher structure.
+ * @param status Status message of the philosopher.
+ * @param timestamp Time of the event, relative to `start_time`.
+ */
+void	live_publish(t_philo *p, const char *status, long timestamp)
+{
+	t_live_slot	*s;
+	t_lock_stat	*f;
+	unsigned	seq;
+
+	if (!p->env->live)
+		return ;
+	s = &p->env->live_slots[p->id];
+	seq = atomic_load_explicit(&s->seq, memory_order_relaxed);
+	atomic_store_explicit(&s->seq, seq + 1, memory_order_relaxed);
+	atomic_thread_fence(memory_order_release);
+	s->state = live_state(status);
+	s->meals = p->env->meals[p->id];
+	if (s->state == LIVE_EATING)
+		s->last_meal = p->env->start_time + timestamp;
+	f = p->env->fork_stats;
+	if (f)
+	{
+		s->contended = f[2 * p->id].contended + f[2 * p->id + 1].contended;
+		s->wait_ns = f[2 * p->id].wait_ns + f[2 * p->id + 1].wait_ns;
+	}
+	atomic_store_explicit(&s->seq, seq + 2, memory_order_release);
+}
+
+/**
+ * @brief Publishes the die time and meal limit of philosophers `lo` to
+ * `hi - 1` once their `--scenario` values are drawn.
+ *
+ * Called by the spawner of their slice. The values never change
+ * afterwards, so they are written outside the seqlock.
+ *
+ * @param env Pointer to the environment structure.
+ * @param lo First philosopher of the slice.
+ * @param hi End of the slice.
+ */
+void	live_timings(t_env *env, int lo, int hi)
+{
+	if (!env->live)
+		return ;
+	while (lo < hi)
+	{
+		env->live_slots[lo].die_time = env->philos[lo].die_time;
+		env->live_slots[lo].meals_limit = env->philos[lo].meals_limit;
+		lo++;
+	}
+}
+
+/**
+ * @brief Publishes the death of philosopher `id`.
+ *
+ * @param env Pointer to the environment structure.
+ * @param id Index of the philosopher that died.
+ */
+void	live_died(t_env *env, int id)
+{
+	if (env->live)
+		atomic_store(&env->live->died, id + 1);
+}
@@ -0,0 +1,147 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   lockstat.c                                         :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: imunaev- <imunaev-@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/03/28 10:21:44 by imunaev-          #+#    #+#             */
+/*   Updated: 2025/03/28 10:21:44 by imunaev-         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file lockstat.c
+ * @brief Contention counters of the fork and global mutexes.
+ *
+ * With `--lockstat`, every acquisition first tries the lock and only times
+ * the wait when that fails. Counters are never shared between threads:
+ * fork counters belong to the philosopher taking the fork, and the global
+ * mutexes are counted in a block owned by the calling thread. Without the
+ * option both wrappers are a plain `pthread_mutex_lock()`.
+ */
+
+#include "philo.h"
+#include <time.h>
+
+/**
+ * @brief Locks `m` and counts the acquisition in `s`.
+ *
+ * @param s Counters of the mutex, owned by the calling thread.
+ * @param m The mutex.
+ */
+static void	lock_record(t_lock_stat *s, pthread_mutex_t *m)
+{
+	struct timespec	t0;
+	struct timespec	t1;
+	long			wait;
+
+	s->acquired++;
+	if (pthread_mutex_trylock(m) == 0)
+		return ;
+	clock_gettime(CLOCK_MONOTONIC, &t0);
+	pthread_mutex_lock(m);
+	clock_gettime(CLOCK_MONOTONIC, &t1);
+	wait = (t1.tv_sec - t0.tv_sec) * 1000000000L + t1.tv_nsec - t0.tv_nsec;
+	s->contended++;
+	s->wait_ns += wait;
+	if (wait > s->max_ns)
+		s->max_ns = wait;
+}
+
+/**
+ * @brief Returns the calling thread's block of global mutex counters.
+ *
+ * The block is created on first use and pushed on `env->lock_blocks`.
+ *
+ * @param env Pointer to the environment structure.
+ * @return t_lock_block* The block, or NULL if it could not be allocated.
+ */
+static t_lock_block	*thread_block(t_env *env)
+{
+	t_lock_block	*b;
+
+	b = pthread_getspecific(env->lock_key);
+	if (b)
+		return (b);
+	b = malloc(sizeof(t_lock_block));
+	if (!b)
+		return (NULL);
+	memset(b, 0, sizeof(t_lock_block));
+	b->next = atomic_load(&env->lock_blocks);
+	while (!atomic_compare_exchange_weak(&env->lock_blocks, &b->next, b))
+		continue ;
+	(void)pthread_setspecific(env->lock_key, b);
+	return (b);
+}
+
+/**
+ * @brief Locks one of the global mutexes.
+ *
+ * Thread safety:
+ * - Only the calling thread writes its counter block.
+ *
+ * @param env Pointer to the environment structure.
+ * @param m The mutex.
+ * @param id Which global mutex `m` is.
+ */
+void	stat_lock(t_env *env, pthread_mutex_t *m, t_lock_id id)
+{
+	t_lock_block	*b;
+
+	b = NULL;
+	if (env->lock_key_created)
+		b = thread_block(env);
+	if (b)
+		lock_record(&b->locks[id], m);
+	else
+		pthread_mutex_lock(m);
+}
+
+/**
+ * @brief Locks fork mutex `fork`, one of the two of philosopher `p`.
+ *
+ * Thread safety:
+ * - Philosopher `p` keeps the counters for fork `p->id` and the fork after
+ *   it in its own two slots of `env->fork_stats`.
+ *
+ * @param p Pointer to the philosopher structure.
+ * @param fork Index of the fork.
+ */
+void	stat_lock_fork(t_philo *p, int fork)
+{
+	t_env	*env;
+
+	env = p->env;
+	if (env->fork_stats)
+		lock_record(&env->fork_stats[2 * p->id + (fork != p->id)],
+			&env->forks[fork]);
+	else
+		pthread_mutex_lock(&env->forks[fork]);
+}
+
+/**
+ * @brief Sets up the counters when `--lockstat` is given.
+ *
+ * The fork counters, two per philosopher, are carved from the arena when
+ * forks are mutexes; the per-thread blocks are found through a thread key.
+ *
+ * @param env Pointer to the environment structure.
+ * @return int Returns EXIT_SUCCESS on success, otherwise EXIT_FAILURE.
+ */
+int	alloc_lockstat(t_env *env)
+{
+	if (!env->opts.lockstat)
+		return (EXIT_SUCCESS);
+	if (env->opts.fork_mode == FORK_MUTEX)
+	{
+		env->fork_stats = arena_carve(&env->arena,
+				2 * env->cfg.num_philo * sizeof(t_lock_stat));
+		if (!env->fork_stats)
+			return (EXIT_FAILURE);
+	}
+	if (pthread_key_create(&env->lock_key, NULL) != 0)
+		return (EXIT_FAILURE);
+	env->lock_key_created = true;
+	return (EXIT_SUCCESS);
+}
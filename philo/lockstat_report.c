@@ -0,0 +1,154 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   lockstat_report.c                                  :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: imunaev- <imunaev-@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/03/28 11:03:27 by imunaev-          #+#    #+#             */
+/*   Updated: 2025/03/28 11:03:27 by imunaev-         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file lockstat_report.c
+ * @brief Merging and ranking of the `--lockstat` counters.
+ */
+
+#include "philo.h"
+
+/**
+ * @brief Adds the counters of `src` to `dst`.
+ *
+ * @param dst Pointer to the merged counters.
+ * @param src Pointer to one thread's counters.
+ */
+static void	add_stat(t_lock_stat *dst, const t_lock_stat *src)
+{
+	dst->acquired += src->acquired;
+	dst->contended += src->contended;
+	dst->wait_ns += src->wait_ns;
+	if (src->max_ns > dst->max_ns)
+		dst->max_ns = src->max_ns;
+}
+
+/**
+ * @brief Merges the counters of every lock into one array.
+ *
+ * Entries `0` to `LOCK_GLOBALS - 1` are the global mutexes, summed over
+ * the thread blocks; the forks follow, each summed over the two
+ * philosophers sharing it (slot `2 * p` of philosopher `p` is fork `p`,
+ * slot `2 * p + 1` the fork after it).
+ *
+ * @param env Pointer to the environment structure.
+ * @param n Number of forks with counters.
+ * @return t_lock_stat* The merged counters (to be freed), or NULL.
+ */
+static t_lock_stat	*lock_totals(t_env *env, int n)
+{
+	t_lock_stat		*t;
+	t_lock_block	*b;
+	int				i;
+
+	t = calloc(LOCK_GLOBALS + n, sizeof(t_lock_stat));
+	if (!t)
+		return (NULL);
+	b = atomic_load(&env->lock_blocks);
+	while (b)
+	{
+		i = 0;
+		while (i < LOCK_GLOBALS)
+		{
+			add_stat(&t[i], &b->locks[i]);
+			i++;
+		}
+		b = b->next;
+	}
+	i = 0;
+	while (i < 2 * n)
+	{
+		add_stat(&t[LOCK_GLOBALS + (i / 2 + i % 2) % n], &env->fork_stats[i]);
+		i++;
+	}
+	return (t);
+}
+
+/**
+ * @brief Prints the counters of lock `i` of the merged array.
+ *
+ * @param i Index in the merged array.
+ * @param s Pointer to the merged counters of the lock.
+ */
+static void	print_lock(int i, const t_lock_stat *s)
+{
+	static const char *const	names[] = {"meal_mutex", "end_mutex",
+		"print_mutex", "log_buffer.mutex"};
+	char						name[24];
+	long						permille;
+
+	if (i < LOCK_GLOBALS)
+		snprintf(name, sizeof(name), "%s", names[i]);
+	else
+		snprintf(name, sizeof(name), "fork %d", i - LOCK_GLOBALS + 1);
+	permille = s->contended * 1000 / (s->acquired + !s->acquired);
+	fprintf(stderr, "lock %-16s %ld acquired, %ld contended (%ld.%ld%%), "
+		"wait %ld us, max %ld us\n", name, s->acquired, s->contended,
+		permille / 10, permille % 10, s->wait_ns / 1000, s->max_ns / 1000);
+}
+
+/**
+ * @brief Returns the lock with the longest total wait among those taken.
+ *
+ * @param t The merged counters.
+ * @param count Number of entries in `t`.
+ * @return int Index of that lock, or -1 if none is left.
+ */
+static int	next_lock(const t_lock_stat *t, int count)
+{
+	int	best;
+	int	i;
+
+	best = -1;
+	i = 0;
+	while (i < count)
+	{
+		if (t[i].acquired > 0 && (best < 0 || t[i].wait_ns > t[best].wait_ns))
+			best = i;
+		i++;
+	}
+	return (best);
+}
+
+/**
+ * @brief Prints the `LOCK_ROWS` locks with the longest total wait.
+ *
+ * Printed entries are dropped from the ranking by clearing their
+ * acquisition count.
+ *
+ * @param env Pointer to the environment structure.
+ */
+void	report_locks(t_env *env)
+{
+	t_lock_stat	*t;
+	int			n;
+	int			rows;
+	int			best;
+
+	n = 0;
+	if (env->fork_stats)
+		n = env->cfg.num_philo;
+	t = lock_totals(env, n);
+	if (!t)
+		return ;
+	fprintf(stderr, "lock contention, by total wait:\n");
+	rows = 0;
+	best = next_lock(t, LOCK_GLOBALS + n);
+	while (rows < LOCK_ROWS && best >= 0)
+	{
+		print_lock(best, &t[best]);
+		t[best].acquired = 0;
+		best = next_lock(t, LOCK_GLOBALS + n);
+		rows++;
+	}
+	free(t);
+}
@@ -27,17 +27,20 @@
  * This function stores philosopher events in a shared log buffer. It ensures
  * thread safety by locking the buffer while adding new entries.
  *
- * @param buf Pointer to the log buffer.
+ * @param env Pointer to the environment structure.
  * @param timestamp Time at which the event occurred.
  * @param id Philosopher ID.
  * @param status Status message of the philosopher.
  */
-void	buffered_print(t_log_buffer *buf,
+void	buffered_print(t_env *env,
 					long timestamp,
 					int id,
 					const char *status)
 {
-	pthread_mutex_lock(&buf->mutex);
+	t_log_buffer	*buf;
+
+	buf = &env->log_buffer;
+	stat_lock(env, &buf->mutex, LOCK_LOG);
 	if (buf->count < LOG_BUFFER_SIZE)
 	{
 		buf->entries[buf->count].timestamp = timestamp;
@@ -57,7 +60,9 @@ void	buffered_print(t_log_buffer *buf,
  * This function records the philosopher's state (e.g., eating, thinking,
  * sleeping)
  * by capturing the event timestamp relative to the simulation start time and
- * storing it in the log buffer.
+ * storing it in the log buffer, unless the run is quiet (batch mode).
+ * With `--live` the new state is also
+ * published in the philosopher's shared memory slot.
  *
  * @param p Pointer to the philosopher structure.
  * @param status Status message of the philosopher.
@@ -67,24 +72,29 @@ void	print_status(t_philo *p, const char *status)
 	long	timestamp;
 
 	timestamp = get_time() - p->env->start_time;
-	buffered_print(&p->env->log_buffer, timestamp, p->id + 1, status);
+	if (!p->env->opts.quiet)
+		buffered_print(p->env, timestamp, p->id + 1, status);
+	live_publish(p, status, timestamp);
 }
 
 /**
  * @brief Flushes log entries to standard output.
  *
  * This function prints all buffered log entries in a thread-safe manner.
- * After printing, the buffer is cleared for new entries.
+ * After printing, the buffer is cleared for new entries. With `--trace`
+ * the entries are also copied to `env->trace->batch`, which
+ * `log_flusher()` writes to the trace file once it released the buffer.
  *
  * @param env Pointer to the environment structure.
  * @param log_count Number of log entries to flush.
  */
-static void	flush_log_entries(t_env *env, int log_count)
+void	flush_log_entries(t_env *env, int log_count)
 {
 	int	i;
 
+	DTRACE_PROBE1(philo, log_flush_begin, log_count);
 	i = 0;
-	pthread_mutex_lock(&env->print_mutex);
+	stat_lock(env, &env->print_mutex, LOCK_PRINT);
 	while (i < log_count)
 	{
 		printf("%ld %d %s\n",
@@ -95,6 +105,13 @@ static void	flush_log_entries(t_env *env, int log_count)
 	}
 	env->log_buffer.count = 0;
 	pthread_mutex_unlock(&env->print_mutex);
+	if (env->trace)
+	{
+		memcpy(env->trace->batch, env->log_buffer.entries,
+			log_count * sizeof(t_log_entry));
+		env->trace->batch_count = log_count;
+	}
+	DTRACE_PROBE1(philo, log_flush_end, log_count);
 }
 
 /**
@@ -112,10 +129,10 @@ static int	should_exit_log_flusher(t_env *env, int *log_count)
 {
 	int	ended_local;
 
-	pthread_mutex_lock(&env->end_mutex);
+	stat_lock(env, &env->end_mutex, LOCK_END);
 	ended_local = env->ended;
 	pthread_mutex_unlock(&env->end_mutex);
-	pthread_mutex_lock(&env->log_buffer.mutex);
+	stat_lock(env, &env->log_buffer.mutex, LOCK_LOG);
 	*log_count = env->log_buffer.count;
 	if (ended_local && *log_count == 0)
 	{
@@ -130,7 +147,8 @@ static int	should_exit_log_flusher(t_env *env, int *log_count)
  *
  * This function runs in a separate thread and continuously flushes
  * the log buffer. It ensures logs are printed periodically and exits
- * when the simulation ends and all logs have been printed.
+ * when the simulation ends and all logs have been printed. With `--trace`
+ * each batch is traced after the buffer is unlocked.
  *
  * @param arg Pointer to the environment structure (`t_env`).
  * @return NULL when the thread exits.
@@ -147,6 +165,9 @@ void	*log_flusher(void *arg)
 			break ;
 		flush_log_entries(env, log_count);
 		pthread_mutex_unlock(&env->log_buffer.mutex);
+		if (env->trace)
+			trace_entries(env->trace, env->trace->batch,
+				env->trace->batch_count);
 		usleep(1000);
 	}
 	return (NULL);
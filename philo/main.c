@@ -23,10 +23,13 @@
 /**
  * @brief Main function to initialize and start the philosopher simulation.
  *
- * - Validates command-line arguments.
+ * - Parses leading `--name=value` options and validates the arguments.
+ *   With `--batch` and no other arguments, runs the batch instead (see
+ *   `run_batch()`).
  * - Initializes the simulation environment.
  * - Starts philosopher, monitor, and logger threads.
- * - Waits for threads to finish and cleans up resources.
+ * - Waits for threads to finish, prints the optional run report and cleans
+ *   up resources.
  *
  * @param ac Argument count.
  * @param av Argument vector.
@@ -36,25 +39,28 @@
 int	main(int ac, char **av)
 {
 	t_env		*env;
-	pthread_t	mon;
+	t_opts		opts;
 	pthread_t	logger_thread;
+	int			skip;
+	int			status;
 
-	if (!validate_args(ac, av))
+	init_opts(&opts);
+	skip = parse_options(&opts, ac, av);
+	if (skip >= 0 && opts.batch && skip == ac - 1)
+		return (run_batch(&opts));
+	if (skip < 0 || opts.batch || !validate_args(ac - skip, av + skip))
 	{
-		print_error("Usage (only digits): ./philo num die eat sleep [meals]\n");
+		print_usage();
 		return (EXIT_FAILURE);
 	}
-	init_program(&env, ac, av);
-	mon = 0;
+	init_program(&env, &opts, ac - skip, av + skip);
 	logger_thread = 0;
-	if (start_threads(env, &mon, &logger_thread) == EXIT_FAILURE)
-	{
+	status = start_threads(env, &logger_thread);
+	if (status == EXIT_FAILURE)
 		print_error("Error: main: start_threads failed\n");
-		join_threads(env, mon, logger_thread);
-		free_all(env);
-		return (EXIT_FAILURE);
-	}
-	join_threads(env, mon, logger_thread);
+	join_threads(env, logger_thread);
+	if (status == EXIT_SUCCESS)
+		print_report(env);
 	free_all(env);
-	return (EXIT_SUCCESS);
+	return (status);
 }
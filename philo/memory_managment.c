@@ -19,6 +19,7 @@
  */
 
 #include "philo.h"
+#include <sys/mman.h>
 
 /**
  * @brief Destroys all mutexes used in the simulation.
@@ -37,11 +38,10 @@ void	destroy_mutexes(t_env *env)
 		return ;
 	(void)pthread_mutex_destroy(&env->print_mutex);
 	(void)pthread_mutex_destroy(&env->meal_mutex);
-	(void)pthread_mutex_destroy(&env->start_mutex);
 	(void)pthread_mutex_destroy(&env->end_mutex);
 	(void)pthread_mutex_destroy(&env->log_buffer.mutex);
 	i = 0;
-	while (i < env->num_philo)
+	while (env->forks && i < env->cfg.num_philo)
 	{
 		(void)pthread_mutex_destroy(&env->forks[i]);
 		i++;
@@ -51,27 +51,63 @@ void	destroy_mutexes(t_env *env)
 /**
  * @brief Frees allocated memory for environment structures.
  *
- * This function releases memory allocated for forks and philosopher structures,
- * ensuring that all dynamically allocated resources are properly freed.
+ * This function releases the optional structures and then unmaps the
+ * arena holding the environment, the forks (mutexes or the fork bitmap) and
+ * the philosopher structures, ensuring that all dynamically allocated
+ * resources are properly freed. A batch runner's arena is kept mapped for
+ * its next run.
  *
  * @param env Pointer to the environment structure.
  */
 void	free_env(t_env *env)
 {
+	t_arena	arena;
+
 	if (!env)
 		return ;
-	if (env->forks)
-	{
-		free(env->forks);
-		env->forks = NULL;
-	}
-	if (env->philos)
+	free(env->fork_node);
+	free_shards(env);
+	free_pool(env);
+	free_coro(env);
+	free_lockstat(env);
+	free_live(env);
+	free_trace(env);
+	free_grants(env);
+	free_scenario(env);
+	arena = env->arena;
+	if (!arena.keep)
+		(void)munmap(arena.base, arena.size);
+}
+
+/**
+ * @brief Releases the monitor shards and their deadline heaps.
+ *
+ * A non-NULL heap always has an initialized mutex and condition variable,
+ * so they are destroyed together with the heap arrays.
+ *
+ * @param env Pointer to the environment structure.
+ */
+void	free_shards(t_env *env)
+{
+	int				i;
+	t_deadline_heap	*h;
+
+	i = 0;
+	while (env->shards && i < env->num_shards)
 	{
-		free(env->philos);
-		env->philos = NULL;
+		h = &env->shards[i].heap;
+		if (h->heap)
+		{
+			(void)pthread_mutex_destroy(&h->mutex);
+			(void)pthread_cond_destroy(&h->cond);
+		}
+		free(h->heap);
+		free(h->pos);
+		free(h->deadline);
+		i++;
 	}
-	free(env);
-	env = NULL;
+	free(env->shards);
+	env->shards = NULL;
 }
 
 /**
@@ -89,3 +125,27 @@ void	free_all(t_env *env)
 	destroy_mutexes(env);
 	free_env(env);
 }
+
+/**
+ * @brief Frees the per-thread lock counter blocks and the thread key.
+ *
+ * @param env Pointer to the environment structure.
+ */
+void	free_lockstat(t_env *env)
+{
+	t_lock_block	*b;
+	t_lock_block	*next;
+
+	if (!env->lock_key_created)
+		return ;
+	b = atomic_load(&env->lock_blocks);
+	while (b)
+	{
+		next = b->next;
+		free(b);
+		b = next;
+	}
+	atomic_store(&env->lock_blocks, NULL);
+	(void)pthread_key_delete(env->lock_key);
+	env->lock_key_created = false;
+}
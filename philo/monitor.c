@@ -25,73 +25,61 @@
 /**
  * @brief Checks if a philosopher has died.
  *
- * This function calculates the time since a philosopher's last meal and
- * compares
- * it with the allowed die time. If the philosopher has exceeded the time limit,
- * the function marks the simulation as ended and prints a death message.
+ * This function compares the current time with the philosopher's death
+ * deadline, its last meal plus its own die time. If the philosopher has
+ * reached the deadline, the function marks the simulation as ended and
+ * announces the death (see `announce_death()`) after waking the heap
+ * monitors. With several monitor shards only the first shard to set
+ * `ended` announces it.
  *
  * Thread safety:
- * - Uses `meal_mutex` to safely access each philosopher's last meal time.
+ * - Uses `meal_mutex` to safely access each philosopher's deadline.
  * - Uses `end_mutex` to update the simulation termination flag.
- * - Uses `print_mutex` to print the death message without race conditions.
  *
  * @param env Pointer to the environment structure.
  * @param i Index of the philosopher to check.
  * @return 1 if a philosopher has died, otherwise 0.
  */
-static int	check_death(t_env *env, int i)
+int	check_death(t_env *env, int i)
 {
-	long	time_since_meal;
+	long	deadline;
+	long	now;
+	bool	first;
 
-	pthread_mutex_lock(&env->meal_mutex);
-	time_since_meal = get_time() - env->philos[i].last_meal;
+	stat_lock(env, &env->meal_mutex, LOCK_MEAL);
+	deadline = env->deadline[i];
 	pthread_mutex_unlock(&env->meal_mutex);
-	if (time_since_meal > env->die_time)
-	{
-		pthread_mutex_lock(&env->end_mutex);
-		if (!env->ended)
-			env->ended = 1;
-		pthread_mutex_unlock(&env->end_mutex);
-		pthread_mutex_lock(&env->print_mutex);
-		printf("%ld %d died\n", get_time() - env->start_time, i + 1);
-		pthread_mutex_unlock(&env->print_mutex);
+	now = get_time_us();
+	if (now / 1000 < deadline)
+		return (0);
+	stat_lock(env, &env->end_mutex, LOCK_END);
+	first = !env->ended;
+	env->ended = 1;
+	pthread_mutex_unlock(&env->end_mutex);
+	if (!first)
 		return (1);
-	}
-	return (0);
+	wake_monitors(env);
+	announce_death(env, i, now, deadline);
+	return (1);
 }
 
 /**
  * @brief Checks if all philosophers have eaten enough meals.
  *
  * This function verifies if every philosopher has reached the required meal
- * limit.
- * If all philosophers have consumed the required number of meals, it marks the
- * simulation as ended.
+ * limit by reading the `satiated` counter, which each philosopher increments
+ * once when it reaches the limit (see `count_meal()`). Philosophers without
+ * a limit never do, so a table with one of them never gets full.
  *
  * Thread safety:
- * - Uses `meal_mutex` to safely access meal counts.
+ * - Reads the atomic `satiated` counter, no mutex is required.
  *
  * @param env Pointer to the environment structure.
  * @return 1 if all philosophers have eaten enough, otherwise 0.
  */
-static int	check_full(t_env *env)
+int	check_full(t_env *env)
 {
-	int	i;
-	int	full_count;
-
-	if (env->meals_limit == -1)
-		return (0);
-	full_count = 0;
-	i = 0;
-	while (i < env->num_philo)
-	{
-		pthread_mutex_lock(&env->meal_mutex);
-		if (env->philos[i].meals >= env->meals_limit)
-			full_count++;
-		pthread_mutex_unlock(&env->meal_mutex);
-		i++;
-	}
-	return (full_count == env->num_philo);
+	return (atomic_load(&env->satiated) >= env->cfg.num_philo);
 }
 
 /**
@@ -106,9 +94,9 @@ static int	check_full(t_env *env)
  * @param env Pointer to the environment structure.
  * @return 1 if the simulation should end, otherwise 0.
  */
-static int	should_terminate(t_env *env)
+int	should_terminate(t_env *env)
 {
-	pthread_mutex_lock(&env->end_mutex);
+	stat_lock(env, &env->end_mutex, LOCK_END);
 	if (env->ended)
 	{
 		pthread_mutex_unlock(&env->end_mutex);
@@ -118,43 +106,83 @@ static int	should_terminate(t_env *env)
 	return (0);
 }
 
+/**
+ * @brief Checks every philosopher of a shard once.
+ *
+ * The shard's deadlines are scanned in chunks of `SCAN_CHUNK` philosophers
+ * with the vector kernel selected at startup, taking `meal_mutex` once per
+ * chunk instead of once per philosopher. Since each philosopher's own die
+ * time is folded into its deadline, one limit (the current time) serves
+ * the whole table. A philosopher the kernel reports is
+ * checked again by `check_death()`, which prints the death.
+ *
+ * @param s Pointer to the monitor shard.
+ * @return 1 if a philosopher has died, otherwise 0.
+ */
+static int	scan_shard(t_monitor_shard *s)
+{
+	long	start;
+	int		i;
+	int		hi;
+
+	start = get_time_us();
+	i = s->lo;
+	while (i < s->hi)
+	{
+		hi = i + SCAN_CHUNK;
+		if (hi > s->hi)
+			hi = s->hi;
+		stat_lock(s->env, &s->env->meal_mutex, LOCK_MEAL);
+		i = s->env->scan.fn(s->env->deadline, i, hi, get_time() + 1);
+		pthread_mutex_unlock(&s->env->meal_mutex);
+		if (i == hi)
+			continue ;
+		if (check_death(s->env, i))
+			return (1);
+		i++;
+	}
+	record_scan(s, get_time_us() - start);
+	return (0);
+}
+
 /**
  * @brief Monitor thread function.
  *
- * This function continuously checks if a philosopher has died or if all
- * philosophers have eaten enough meals. If either condition is met, it
- * marks the simulation as ended and exits the thread.
+ * Each monitor shard runs this function over its own range of
+ * philosophers. It continuously checks if a philosopher has died and, in
+ * the first shard, whether all philosophers have eaten enough meals. If
+ * either condition is met, it marks the simulation as ended and exits the
+ * thread. Monitoring begins at the start instant published by the start
+ * gate. With `--monitor=heap` the work is handed to `monitor_heap()`.
  *
  * Thread safety:
  * - Uses `end_mutex`, `meal_mutex`, and `print_mutex` to ensure safe access
  *   to shared data.
  *
- * @param arg Pointer to the environment structure (`t_env`).
+ * @param arg Pointer to the monitor shard (`t_monitor_shard`).
  * @return NULL when the monitoring thread exits.
  */
 void	*monitor(void *arg)
 {
-	t_env	*env;
-	int		i;
+	t_monitor_shard	*s;
+	t_env			*env;
 
-	env = (t_env *)arg;
+	s = (t_monitor_shard *)arg;
+	env = s->env;
+	(void)await_start(env);
+	if (env->opts.monitor_mode == MONITOR_HEAP)
+		return (monitor_heap(s));
 	while (1)
 	{
-		usleep(5000);
-		if (should_terminate(env))
+		usleep(MONITOR_TICK_MS * 1000);
+		if (should_terminate(env) || scan_shard(s))
 			break ;
-		i = 0;
-		while (i < env->num_philo)
-		{
-			if (check_death(env, i))
-				return (NULL);
-			i++;
-		}
-		if (check_full(env))
+		if (s->lo == 0 && check_full(env))
 		{
-			pthread_mutex_lock(&env->end_mutex);
+			stat_lock(env, &env->end_mutex, LOCK_END);
 			env->ended = 1;
 			pthread_mutex_unlock(&env->end_mutex);
+			wake_monitors(env);
 		}
 	}
 	return (NULL);
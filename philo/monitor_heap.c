@@ -0,0 +1,182 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   monitor_heap.c                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: imunaev- <imunaev-@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/03/19 15:47:02 by imunaev-          #+#    #+#             */
+/*   Updated: 2025/03/19 15:47:02 by imunaev-         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file monitor_heap.c
+ * @brief Event-driven monitor built on the deadline heap.
+ *
+ * Instead of scanning every philosopher each tick, this monitor sleeps
+ * until the earliest death deadline and then re-checks only the philosopher
+ * that owns it, so detection latency no longer grows with the number of
+ * philosophers. Whoever ends the simulation wakes the heap monitors with
+ * `wake_monitors()`, so they never wake up just to poll the end flag.
+ */
+
+#include "philo.h"
+#include <limits.h>
+
+/**
+ * @brief Waits on the heap condition until the absolute time `ms`.
+ *
+ * The default condition clock is the same realtime clock used by
+ * `get_time()`, so deadlines can be used as they are. A LONG_MAX deadline,
+ * left once every philosopher of the heap is satiated, waits for a
+ * broadcast only.
+ *
+ * @param h Pointer to the deadline heap, whose mutex is held.
+ * @param ms Absolute wake-up time in milliseconds.
+ */
+void	heap_wait_until(t_deadline_heap *h, long ms)
+{
+	struct timespec	ts;
+
+	if (ms == LONG_MAX)
+	{
+		(void)pthread_cond_wait(&h->cond, &h->mutex);
+		return ;
+	}
+	ts.tv_sec = ms / 1000;
+	ts.tv_nsec = (ms % 1000) * 1000000;
+	(void)pthread_cond_timedwait(&h->cond, &h->mutex, &ts);
+}
+
+/**
+ * @brief Wakes every heap monitor and pool worker so they notice the end
+ * immediately.
+ *
+ * Called by whoever sets `ended`. Polling monitors notice the flag on
+ * their next tick.
+ *
+ * Thread safety:
+ * - Takes each heap and worker timer mutex in turn, after `end_mutex` has
+ *   been released. Monitors and workers read `ended` under that mutex
+ *   before they wait, so the broadcast cannot be lost.
+ *
+ * @param env Pointer to the environment structure.
+ */
+void	wake_monitors(t_env *env)
+{
+	t_deadline_heap	*h;
+	int				i;
+
+	pool_wake_all(env);
+	if (env->opts.monitor_mode != MONITOR_HEAP || !env->shards)
+		return ;
+	i = 0;
+	while (i < env->num_shards)
+	{
+		h = &env->shards[i].heap;
+		pthread_mutex_lock(&h->mutex);
+		pthread_cond_broadcast(&h->cond);
+		pthread_mutex_unlock(&h->mutex);
+		i++;
+	}
+}
+
+/**
+ * @brief Sleeps until the earliest deadline of a shard or checks its owner.
+ *
+ * The sleep is not bounded: the end of the simulation is signalled by
+ * `wake_monitors()`, and a deadline only moves later while the monitor
+ * sleeps. The time spent checking the philosopher is accounted as the
+ * shard's scan time.
+ *
+ * @param s Pointer to the monitor shard.
+ * @return 1 if the simulation has ended or a philosopher has died,
+ * otherwise 0.
+ */
+static int	heap_step(t_monitor_shard *s)
+{
+	t_deadline_heap	*h;
+	long			now;
+	long			wake;
+	int				id;
+	int				ended;
+
+	h = &s->heap;
+	pthread_mutex_lock(&h->mutex);
+	id = h->heap[0];
+	wake = h->deadline[id];
+	id += h->base;
+	now = get_time();
+	ended = should_terminate(s->env);
+	if (!ended && wake > now)
+		heap_wait_until(h, wake);
+	pthread_mutex_unlock(&h->mutex);
+	if (ended || wake > now)
+		return (ended);
+	now = get_time_us();
+	if (check_death(s->env, id))
+		return (1);
+	record_scan(s, get_time_us() - now);
+	return (0);
+}
+
+/**
+ * @brief Monitor loop for the `heap` monitoring strategy.
+ *
+ * Only the first shard checks the meal limit, since it covers all
+ * philosophers at once. It does so before every wait, so a table that
+ * starts satiated (a meal limit of 0) ends without a deadline to wake on;
+ * later the philosopher that completes the table ends the run itself.
+ *
+ * Thread safety:
+ * - Uses the heap mutex to read the earliest deadline.
+ * - Uses `meal_mutex`, `end_mutex` and `print_mutex` through `check_death`.
+ *
+ * @param s Pointer to the monitor shard.
+ * @return NULL when the monitoring loop exits.
+ */
+void	*monitor_heap(t_monitor_shard *s)
+{
+	t_env	*env;
+
+	env = s->env;
+	while (1)
+	{
+		if (s->lo == 0 && check_full(env))
+		{
+			stat_lock(env, &env->end_mutex, LOCK_END);
+			env->ended = 1;
+			pthread_mutex_unlock(&env->end_mutex);
+			wake_monitors(env);
+		}
+		if (heap_step(s))
+			break ;
+	}
+	return (NULL);
+}
+
+/**
+ * @brief Moves a philosopher's deadline forward after it starts eating,
+ * or to LONG_MAX once it ate its meal limit when the limits are mixed.
+ *
+ * The update goes to the heap of the shard that owns the philosopher.
+ *
+ * Thread safety:
+ * - Uses the heap's own mutex, which is never held together with
+ *   `meal_mutex` by the philosopher.
+ *
+ * @param env Pointer to the environment structure.
+ * @param id Index of the philosopher.
+ * @param deadline New deadline in milliseconds.
+ */
+void	deadline_heap_update(t_env *env, int id, long deadline)
+{
+	t_deadline_heap	*h;
+
+	h = &env->shards[id / env->shard_size].heap;
+	id -= h->base;
+	pthread_mutex_lock(&h->mutex);
+	heap_set_key(h, id, deadline);
+	pthread_mutex_unlock(&h->mutex);
+}
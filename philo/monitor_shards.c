@@ -0,0 +1,124 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   monitor_shards.c                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: imunaev- <imunaev-@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/03/20 09:14:27 by imunaev-          #+#    #+#             */
+/*   Updated: 2025/03/20 09:14:27 by imunaev-         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file monitor_shards.c
+ * @brief Creation and bookkeeping of the sharded monitor threads.
+ *
+ * The philosophers are split into contiguous ranges, one per monitor
+ * shard. Each shard runs the selected monitoring strategy over its own
+ * range and publishes a death through the shared `ended` flag. With more
+ * than one shard, each shard is pinned to its own core, or with
+ * `--placement=numa` to a core of the node of its philosophers.
+ */
+
+#define _GNU_SOURCE
+#include "philo.h"
+#include <sched.h>
+
+/**
+ * @brief Pins a shard thread to core `index` modulo the online core count.
+ *
+ * Pinning is best effort: a failure only costs locality, so it is ignored.
+ *
+ * @param s Pointer to the shard.
+ * @param index Index of the shard.
+ */
+static void	pin_shard(t_monitor_shard *s, int index)
+{
+	cpu_set_t	set;
+	long		cores;
+
+	cores = sysconf(_SC_NPROCESSORS_ONLN);
+	if (cores < 2)
+		return ;
+	CPU_ZERO(&set);
+	CPU_SET(index % cores, &set);
+	(void)pthread_setaffinity_np(s->thread, sizeof(set), &set);
+}
+
+/**
+ * @brief Creates one monitor thread per shard.
+ *
+ * If a thread fails to create, it sets `env->ended` to true and opens the
+ * start gate so that the shards already created can exit; they are joined
+ * later by `join_monitor_threads()`.
+ *
+ * Thread safety:
+ * - Uses `end_mutex` to safely update the `ended` flag upon failure.
+ *
+ * @param env Pointer to the environment structure.
+ * @return int Returns EXIT_SUCCESS if all threads are created successfully,
+ * otherwise EXIT_FAILURE.
+ */
+int	create_monitor_threads(t_env *env)
+{
+	int	i;
+
+	i = 0;
+	while (i < env->num_shards)
+	{
+		if (start_thread(env, &env->shards[i].thread, monitor,
+				&env->shards[i]) != 0)
+		{
+			print_error("Error: Failed to create monitor thread\n");
+			stat_lock(env, &env->end_mutex, LOCK_END);
+			env->ended = true;
+			pthread_mutex_unlock(&env->end_mutex);
+			wake_monitors(env);
+			release_start_gate(env, get_time());
+			return (EXIT_FAILURE);
+		}
+		env->shards[i].created = true;
+		if (env->opts.placement == PLACE_NUMA)
+			place_thread(env, env->shards[i].thread, env->shards[i].lo);
+		else if (env->num_shards > 1)
+			pin_shard(&env->shards[i], i);
+		i++;
+	}
+	return (EXIT_SUCCESS);
+}
+
+/**
+ * @brief Joins every monitor shard thread that was created.
+ *
+ * @param env Pointer to the environment structure.
+ */
+void	join_monitor_threads(t_env *env)
+{
+	int	i;
+
+	i = 0;
+	while (env->shards && i < env->num_shards)
+	{
+		if (env->shards[i].created)
+			pthread_join(env->shards[i].thread, NULL);
+		i++;
+	}
+}
+
+/**
+ * @brief Accounts the duration of one scan of a shard.
+ *
+ * Only the shard's own thread writes these counters; they are read after
+ * the thread is joined.
+ *
+ * @param s Pointer to the shard.
+ * @param us Duration of the scan in microseconds.
+ */
+void	record_scan(t_monitor_shard *s, long us)
+{
+	s->scans++;
+	s->scan_total_us += us;
+	if (us > s->scan_max_us)
+		s->scan_max_us = us;
+}
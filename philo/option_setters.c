@@ -0,0 +1,104 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   option_setters.c                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: imunaev- <imunaev-@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/03/19 16:05:12 by imunaev-          #+#    #+#             */
+/*   Updated: 2025/03/19 16:05:12 by imunaev-         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file option_setters.c
+ * @brief Value parsers for the `--name=value` run-time options.
+ *
+ * Each setter validates one option value and stores it in `t_opts`.
+ */
+
+#include "philo.h"
+
+/**
+ * @brief Looks `val` up in a NULL-terminated list of names.
+ *
+ * @param val The option value.
+ * @param names NULL-terminated list of accepted values.
+ * @return int Index of the matching name, or -1 if there is none.
+ */
+int	opt_choice(const char *val, const char *const *names)
+{
+	int	i;
+
+	i = 0;
+	while (names[i])
+	{
+		if (ft_strncmp(val, names[i], ft_strlen(names[i]) + 1) == 0)
+			return (i);
+		i++;
+	}
+	return (-1);
+}
+
+/**
+ * @brief Parses `--forks=mutex|bitmap`.
+ *
+ * @param opts Pointer to the options structure.
+ * @param val The option value.
+ * @return int Returns EXIT_SUCCESS on a valid value, otherwise EXIT_FAILURE.
+ */
+int	set_fork_mode(t_opts *opts, const char *val)
+{
+	static const char *const	names[] = {"mutex", "bitmap", NULL};
+	int							i;
+
+	i = opt_choice(val, names);
+	if (i < 0)
+		return (EXIT_FAILURE);
+	opts->fork_mode = (t_fork_mode)i;
+	opts->forks_set = true;
+	return (EXIT_SUCCESS);
+}
+
+/**
+ * @brief Parses `--monitor=poll|heap`.
+ *
+ * @param opts Pointer to the options structure.
+ * @param val The option value.
+ * @return int Returns EXIT_SUCCESS on a valid value, otherwise EXIT_FAILURE.
+ */
+int	set_monitor_mode(t_opts *opts, const char *val)
+{
+	static const char *const	names[] = {"poll", "heap", NULL};
+	int							i;
+
+	i = opt_choice(val, names);
+	if (i < 0)
+		return (EXIT_FAILURE);
+	opts->monitor_mode = (t_monitor_mode)i;
+	return (EXIT_SUCCESS);
+}
+
+/**
+ * @brief Parses `--engine=thread|pool|coro`.
+ *
+ * The pool engine releases forks from whichever worker runs the
+ * philosopher, so it always uses the fork bitmap, which has no owner. The
+ * coroutine engine uses it too, because a coroutine must try for its forks
+ * without blocking its carrier thread.
+ *
+ * @param opts Pointer to the options structure.
+ * @param val The option value.
+ * @return int Returns EXIT_SUCCESS on a valid value, otherwise EXIT_FAILURE.
+ */
+int	set_engine(t_opts *opts, const char *val)
+{
+	static const char *const	names[] = {"thread", "pool", "coro", NULL};
+	int							i;
+
+	i = opt_choice(val, names);
+	if (i < 0)
+		return (EXIT_FAILURE);
+	opts->engine = (t_engine)i;
+	return (EXIT_SUCCESS);
+}
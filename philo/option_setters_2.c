@@ -0,0 +1,103 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   option_setters_2.c                                 :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: imunaev- <imunaev-@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/03/20 14:36:09 by imunaev-          #+#    #+#             */
+/*   Updated: 2025/03/20 14:36:09 by imunaev-         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file option_setters_2.c
+ * @brief Value parsers for the numeric and placement run-time options.
+ */
+
+#include "philo.h"
+
+/**
+ * @brief Parses a positive decimal option value.
+ *
+ * @param val The option value, digits only.
+ * @param out Where to store the parsed number.
+ * @return int Returns EXIT_SUCCESS if `val` is a number of at least 1,
+ * otherwise EXIT_FAILURE.
+ */
+int	opt_number(const char *val, int *out)
+{
+	int	i;
+
+	i = 0;
+	while (val[i] >= '0' && val[i] <= '9')
+		i++;
+	if (i == 0 || val[i] != '\0' || i > 9 || ft_atoi(val) < 1)
+		return (EXIT_FAILURE);
+	*out = ft_atoi(val);
+	return (EXIT_SUCCESS);
+}
+
+/**
+ * @brief Parses `--shards=N`, the number of monitor threads.
+ *
+ * @param opts Pointer to the options structure.
+ * @param val The option value.
+ * @return int Returns EXIT_SUCCESS on a valid value, otherwise EXIT_FAILURE.
+ */
+int	set_shards(t_opts *opts, const char *val)
+{
+	return (opt_number(val, &opts->shards));
+}
+
+/**
+ * @brief Parses `--workers=N`, the size of the worker pool.
+ *
+ * @param opts Pointer to the options structure.
+ * @param val The option value.
+ * @return int Returns EXIT_SUCCESS on a valid value, otherwise EXIT_FAILURE.
+ */
+int	set_workers(t_opts *opts, const char *val)
+{
+	return (opt_number(val, &opts->workers));
+}
+
+/**
+ * @brief Parses `--placement=none|numa`.
+ *
+ * @param opts Pointer to the options structure.
+ * @param val The option value.
+ * @return int Returns EXIT_SUCCESS on a valid value, otherwise EXIT_FAILURE.
+ */
+int	set_placement(t_opts *opts, const char *val)
+{
+	static const char *const	names[] = {"none", "numa", NULL};
+	int							i;
+
+	i = opt_choice(val, names);
+	if (i < 0)
+		return (EXIT_FAILURE);
+	opts->placement = (t_placement)i;
+	return (EXIT_SUCCESS);
+}
+
+/**
+ * @brief Applies a valueless flag: `--report`, `--lockstat` or `--live`.
+ *
+ * @param opts Pointer to the options structure.
+ * @param arg The command-line argument.
+ * @return int Returns EXIT_SUCCESS if `arg` is a known flag, otherwise
+ * EXIT_FAILURE.
+ */
+int	set_flag(t_opts *opts, const char *arg)
+{
+	if (ft_strncmp(arg, "--report", 9) == 0)
+		opts->report = true;
+	else if (ft_strncmp(arg, "--lockstat", 11) == 0)
+		opts->lockstat = true;
+	else if (ft_strncmp(arg, "--live", 7) == 0)
+		opts->live = true;
+	else
+		return (EXIT_FAILURE);
+	return (EXIT_SUCCESS);
+}
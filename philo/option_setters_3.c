@@ -0,0 +1,80 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   option_setters_3.c                                 :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: imunaev- <imunaev-@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 10:04:12 by imunaev-          #+#    #+#             */
+/*   Updated: 2026/10/19 10:04:12 by imunaev-         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file option_setters_3.c
+ * @brief Value parsers for the `--trace`, `--record` and `--replay`
+ * options.
+ */
+
+#include "philo.h"
+
+/**
+ * @brief Parses `--trace=FILE`, where to write the Chrome trace.
+ *
+ * @param opts Pointer to the options structure.
+ * @param val The option value, kept as is (it points into `argv`).
+ * @return int Returns EXIT_SUCCESS on a non-empty path, otherwise
+ * EXIT_FAILURE.
+ */
+int	set_trace(t_opts *opts, const char *val)
+{
+	if (val[0] == '\0')
+		return (EXIT_FAILURE);
+	opts->trace = val;
+	return (EXIT_SUCCESS);
+}
+
+/**
+ * @brief Parses `--trace-min=MS`, the shortest interval `--trace` keeps
+ * as a slice of its own.
+ *
+ * @param opts Pointer to the options structure.
+ * @param val The option value.
+ * @return int Returns EXIT_SUCCESS on a valid value, otherwise EXIT_FAILURE.
+ */
+int	set_trace_min(t_opts *opts, const char *val)
+{
+	return (opt_number(val, &opts->trace_min));
+}
+
+/**
+ * @brief Parses `--record=FILE`, where to save the fork grant order.
+ *
+ * @param opts Pointer to the options structure.
+ * @param val The option value, kept as is (it points into `argv`).
+ * @return int Returns EXIT_SUCCESS on a non-empty path, otherwise
+ * EXIT_FAILURE.
+ */
+int	set_record(t_opts *opts, const char *val)
+{
+	if (val[0] == '\0')
+		return (EXIT_FAILURE);
+	opts->record = val;
+	return (EXIT_SUCCESS);
+}
+
+/**
+ * @brief Parses `--replay=FILE`, a fork grant order saved by `--record`.
+ *
+ * @param opts Pointer to the options structure.
+ * @param val The option value, kept as is (it points into `argv`).
+ * @return int Returns EXIT_SUCCESS on a non-empty path, otherwise
+ * EXIT_FAILURE.
+ */
+int	set_replay(t_opts *opts, const char *val)
+{
+	if (val[0] == '\0')
+		return (EXIT_FAILURE);
+	opts->replay = val;
+	return (EXIT_SUCCESS);
+}
@@ -0,0 +1,65 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   option_setters_4.c                                 :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: imunaev- <imunaev-@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 14:40:12 by imunaev-          #+#    #+#             */
+/*   Updated: 2026/10/19 14:40:12 by imunaev-         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file option_setters_4.c
+ * @brief Value parsers for the `--batch`, `--jobs` and `--scenario`
+ * options.
+ */
+
+#include "philo.h"
+
+/**
+ * @brief Parses `--batch=FILE`, the configurations to run (see
+ * `run_batch()`).
+ *
+ * @param opts Pointer to the options structure.
+ * @param val The option value, kept as is (it points into `argv`).
+ * @return int Returns EXIT_SUCCESS on a non-empty path, otherwise
+ * EXIT_FAILURE.
+ */
+int	set_batch(t_opts *opts, const char *val)
+{
+	if (val[0] == '\0')
+		return (EXIT_FAILURE);
+	opts->batch = val;
+	return (EXIT_SUCCESS);
+}
+
+/**
+ * @brief Parses `--jobs=N`, how many batch runs go at a time.
+ *
+ * @param opts Pointer to the options structure.
+ * @param val The option value.
+ * @return int Returns EXIT_SUCCESS on a valid value, otherwise EXIT_FAILURE.
+ */
+int	set_jobs(t_opts *opts, const char *val)
+{
+	return (opt_number(val, &opts->jobs));
+}
+
+/**
+ * @brief Parses `--scenario=FILE`, the per-philosopher timings (see
+ * `load_scenario()`).
+ *
+ * @param opts Pointer to the options structure.
+ * @param val The option value, kept as is (it points into `argv`).
+ * @return int Returns EXIT_SUCCESS on a non-empty path, otherwise
+ * EXIT_FAILURE.
+ */
+int	set_scenario(t_opts *opts, const char *val)
+{
+	if (val[0] == '\0')
+		return (EXIT_FAILURE);
+	opts->scenario = val;
+	return (EXIT_SUCCESS);
+}
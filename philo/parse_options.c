@@ -0,0 +1,169 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   parse_options.c                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: imunaev- <imunaev-@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/03/19 10:20:05 by imunaev-          #+#    #+#             */
+/*   Updated: 2025/03/19 10:20:05 by imunaev-         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file parse_options.c
+ * @brief Run-time option parsing for the philosopher simulation.
+ *
+ * Options are given as `--name=value` arguments placed before the usual
+ * positional arguments, so `./philo num die eat sleep [meals]` keeps working
+ * unchanged.
+ */
+
+#include "philo.h"
+
+/**
+ * @brief Sets every run-time option to its default value.
+ *
+ * @param opts Pointer to the options structure to initialize.
+ */
+void	init_opts(t_opts *opts)
+{
+	opts->fork_mode = FORK_MUTEX;
+	opts->monitor_mode = MONITOR_POLL;
+	opts->shards = 1;
+	opts->engine = ENGINE_THREAD;
+	opts->workers = 0;
+	opts->placement = PLACE_NONE;
+	opts->report = false;
+	opts->lockstat = false;
+	opts->live = false;
+	opts->trace = NULL;
+	opts->trace_min = TRACE_MIN_MS;
+	opts->record = NULL;
+	opts->replay = NULL;
+	opts->batch = NULL;
+	opts->jobs = 1;
+	opts->scenario = NULL;
+	opts->quiet = false;
+	opts->forks_set = false;
+}
+
+/**
+ * @brief Returns the value part of `arg` if it starts with `key`.
+ *
+ * @param arg The command-line argument (e.g. `--forks=bitmap`).
+ * @param key The option prefix including `=` (e.g. `--forks=`).
+ * @return const char* Pointer to the value, or NULL if `arg` is another option.
+ */
+static const char	*opt_value(const char *arg, const char *key)
+{
+	size_t	len;
+
+	len = ft_strlen(key);
+	if (ft_strncmp(arg, key, len) != 0)
+		return (NULL);
+	return (arg + len);
+}
+
+/**
+ * @brief Applies a single `--name=value` option.
+ *
+ * Flags are tried first, then each `--name=` prefix of the setter table.
+ *
+ * @param opts Pointer to the options structure.
+ * @param arg The command-line argument.
+ * @return int Returns EXIT_SUCCESS if the option is known and its value is
+ * valid, otherwise EXIT_FAILURE.
+ */
+static int	set_option(t_opts *opts, const char *arg)
+{
+	static const t_opt_setter	setters[] = {
+	{"--forks=", set_fork_mode}, {"--monitor=", set_monitor_mode},
+	{"--shards=", set_shards}, {"--engine=", set_engine},
+	{"--workers=", set_workers}, {"--placement=", set_placement},
+	{"--trace=", set_trace}, {"--trace-min=", set_trace_min},
+	{"--record=", set_record}, {"--replay=", set_replay},
+	{"--batch=", set_batch}, {"--jobs=", set_jobs},
+	{"--scenario=", set_scenario}, {NULL, NULL}};
+	int							i;
+
+	if (set_flag(opts, arg) == EXIT_SUCCESS)
+		return (EXIT_SUCCESS);
+	i = 0;
+	while (setters[i].key)
+	{
+		if (opt_value(arg, setters[i].key))
+			return (setters[i].set(opts, opt_value(arg, setters[i].key)));
+		i++;
+	}
+	return (EXIT_FAILURE);
+}
+
+/**
+ * @brief Parses the leading `--name=value` options.
+ *
+ * Parsing stops at the first argument that does not start with `--`.
+ * The pool and coroutine engines always use the fork bitmap (see
+ * `set_engine()`), so an explicit `--forks=mutex` is rejected with them
+ * rather than silently replaced.
+ *
+ * @param opts Pointer to the options structure to fill.
+ * @param ac Argument count.
+ * @param av Argument vector.
+ * @return int The number of arguments consumed, or -1 on an unknown option,
+ * an invalid value or a rejected combination.
+ */
+int	parse_options(t_opts *opts, int ac, char **av)
+{
+	int	i;
+
+	i = 1;
+	while (i < ac && av[i][0] == '-' && av[i][1] == '-')
+	{
+		if (set_option(opts, av[i]) == EXIT_FAILURE)
+			return (-1);
+		i++;
+	}
+	if (opts->engine != ENGINE_THREAD && opts->forks_set
+		&& opts->fork_mode == FORK_MUTEX)
+	{
+		print_error("Error: --forks=mutex cannot be combined with "
+			"--engine=pool or --engine=coro\n");
+		return (-1);
+	}
+	if (opts->engine != ENGINE_THREAD)
+		opts->fork_mode = FORK_BITMAP;
+	return (i - 1);
+}
+
+/**
+ * @brief Prints the command-line usage message.
+ */
+void	print_usage(void)
+{
+	print_error("Usage (only digits): ./philo [options] num die eat sleep "
+		"[meals]\n       ./philo [options] --batch=FILE\nOptions:\n"
+		"  --forks=mutex|bitmap   fork representation (default: mutex)\n"
+		"  --monitor=poll|heap    death detection strategy (default: poll)\n"
+		"  --shards=N             number of monitor threads (default: 1)\n"
+		"  --engine=thread|pool|coro\n"
+		"                         one thread per philosopher, a worker pool, "
+		"or coroutines\n"
+		"  --workers=N            pool or carrier threads (default: one per "
+		"core)\n"
+		"  --placement=none|numa  pin philosopher blocks to NUMA nodes "
+		"(default: none)\n"
+		"  --report               print run statistics to stderr at exit\n"
+		"  --lockstat             profile fork and global mutex contention\n"
+		"  --live                 publish live stats for philo-top\n"
+		"  --trace=FILE           write a Chrome trace-event timeline\n"
+		"  --trace-min=MS         merge trace intervals shorter than MS "
+		"(default: 2)\n"
+		"  --record=FILE          save the order in which forks are "
+		"granted\n"
+		"  --replay=FILE          grant forks in the order saved by "
+		"--record\n"
+		"  --batch=FILE           run each line of FILE as a configuration\n"
+		"  --jobs=N               batch runs at a time (default: 1)\n"
+		"  --scenario=FILE        per-philosopher timings and meal limits\n");
+}
@@ -41,22 +41,22 @@ static void	self_arrange(t_philo *p)
 	bool	is_odd_philo;
 	bool	is_even_philo;
 
-	is_odd_philo = (p->num_philo & 1);
-	is_even_philo = !(p->num_philo & 1);
+	is_odd_philo = (p->env->cfg.num_philo & 1);
+	is_even_philo = !(p->env->cfg.num_philo & 1);
 	if (is_odd_philo && p->id == 0)
 	{
 		print_status(p, "is thinking");
-		precise_sleep(p->eat_time << 1);
+		philo_sleep(p, p->eat_time << 1);
 	}
 	if (is_odd_philo && (p->id & 1))
 	{
 		print_status(p, "is thinking");
-		precise_sleep(p->eat_time);
+		philo_sleep(p, p->eat_time);
 	}
 	else if (is_even_philo && p->id & 1)
 	{
 		print_status(p, "is thinking");
-		precise_sleep(p->eat_time);
+		philo_sleep(p, p->eat_time);
 	}
 }
 
@@ -65,12 +65,15 @@ static void	self_arrange(t_philo *p)
  *
  * The routine consists of:
  * - Taking forks
- * - Eating (updates last meal time and meal count)
- * - Sleeping
+ * - Eating for its own eat time (updates last meal time, deadline and meal
+ *   count, see `start_meal()`; the meal that reaches its limit is counted
+ *   in the shared `satiated` counter)
+ * - Sleeping, between the `sleep_begin` and `sleep_end` probes
  * - Thinking before repeating the process.
  *
  * Thread safety:
- * - Uses `meal_mutex` to safely update the last meal time and meal count.
+ * - Uses `meal_mutex` to safely update the last meal time and deadline.
+ * - Uses the deadline heap mutex to publish the new death deadline.
  * - Uses mutex locks when taking and releasing forks to prevent race
  * conditions.
  *
@@ -78,23 +81,25 @@ static void	self_arrange(t_philo *p)
  */
 static void	repeat_routine(t_philo *p)
 {
+	t_env	*env;
+
+	env = p->env;
 	take_forks(p);
-	pthread_mutex_lock(&p->env->meal_mutex);
-	p->last_meal = get_time();
-	pthread_mutex_unlock(&p->env->meal_mutex);
+	note_handoff(p);
+	start_meal(p);
 	print_status(p, "is eating");
-	precise_sleep(p->eat_time);
-	pthread_mutex_lock(&p->env->meal_mutex);
-	p->meals++;
-	pthread_mutex_unlock(&p->env->meal_mutex);
+	philo_sleep(p, p->eat_time);
+	count_meal(p);
 	put_forks(p);
 	print_status(p, "is sleeping");
-	precise_sleep(p->sleep_time);
+	DTRACE_PROBE2(philo, sleep_begin, p->id + 1, p->sleep_time);
+	philo_sleep(p, p->sleep_time);
+	DTRACE_PROBE2(philo, sleep_end, p->id + 1, p->sleep_time);
 	print_status(p, "is thinking");
-	if (p->num_philo & 1)
-		precise_sleep(p->sleep_time);
+	if (env->cfg.num_philo & 1)
+		philo_sleep(p, p->sleep_time);
 	else
-		precise_sleep(1);
+		philo_sleep(p, 1);
 }
 
 /**
@@ -102,8 +107,8 @@ static void	repeat_routine(t_philo *p)
  *
  * A single philosopher picks up a fork and is unable to eat, leading to
  *  starvation.
- * This function ensures that the philosopher "dies" after the defined
- * `die_time`.
+ * The philosopher holds its fork until the monitor reports its death after
+ * `die_time` and ends the simulation.
  *
  * @param p Pointer to the philosopher structure.
  */
@@ -111,33 +116,30 @@ static void	repeat_routine(t_philo *p)
 static void	process_single_philo(t_philo *p)
 {
 	print_status(p, "has taken a fork");
-	precise_sleep(p->die_time + 5);
-	pthread_mutex_lock(&p->env->end_mutex);
-	p->env->ended = 1;
-	pthread_mutex_unlock(&p->env->end_mutex);
+	while (!should_terminate(p->env))
+		philo_wait_us(p, 1000);
 }
 
 /**
  * @brief Ensures all threads start at the same simulation time.
  *
- * This function makes philosophers wait until the global `start_time`
- * is reached before beginning execution.
+ * The philosopher announces that it is ready, then waits on the start gate
+ * until the global `start_time` is reached. How late it resumed is kept
+ * in `start_lag` for the run report. A coroutine skips this: its carrier
+ * thread already waited on the gate before resuming it.
  *
  * Thread safety:
- * - Uses `start_mutex` to synchronize all philosophers' starting point.
+ * - Uses the atomic start gate, so no mutex is taken while starting.
  *
  * @param p Pointer to the philosopher structure.
  */
 
 static void	wait_all_threads(t_philo *p)
 {
-	pthread_mutex_lock(&p->env->start_mutex);
-	while (get_time() < p->env->start_time)
-		usleep(50);
-	pthread_mutex_unlock(&p->env->start_mutex);
-	pthread_mutex_lock(&p->env->meal_mutex);
-	p->last_meal = get_time();
-	pthread_mutex_unlock(&p->env->meal_mutex);
+	if (p->coro)
+		return ;
+	announce_ready(p->env);
+	p->start_lag = await_start(p->env);
 }
 
 /**
@@ -150,12 +152,14 @@ static void	wait_all_threads(t_philo *p)
  * - Handles the special case for a single philosopher.
  * - Arranges initial thinking order to reduce contention.
  * - Enters a loop where the philosopher eats, sleeps, and thinks.
+ * - Sleeps through `philo_sleep()`, so the same routine also runs as a
+ *   coroutine with `--engine=coro`.
  * - Checks termination conditions (death or meal limit).
  *
  * Thread safety:
  * - Uses `end_mutex` to check and update the simulation termination state.
  * - Uses `meal_mutex` to track meals and last meal timestamps.
- * - Uses `start_mutex` to synchronize all threads' starting time.
+ * - Uses the start gate to synchronize all threads' starting time.
  *
  * @param arg Pointer to the philosopher structure (`t_philo`).
  * @return NULL when the philosopher exits.
@@ -166,7 +170,7 @@ void	*routine(void *arg)
 
 	p = (t_philo *)arg;
 	wait_all_threads(p);
-	if (p->num_philo == 1)
+	if (p->env->cfg.num_philo == 1)
 	{
 		process_single_philo(p);
 		return (NULL);
@@ -174,16 +178,16 @@ void	*routine(void *arg)
 	self_arrange(p);
 	while (1)
 	{
-		pthread_mutex_lock(&p->env->end_mutex);
-		if (p->env->ended
-			|| (p->meals_limit != -1 && p->meals >= p->meals_limit))
+		stat_lock(p->env, &p->env->end_mutex, LOCK_END);
+		if (p->env->ended || (p->meals_limit != -1
+				&& p->env->meals[p->id] >= p->meals_limit))
 		{
 			pthread_mutex_unlock(&p->env->end_mutex);
 			break ;
 		}
 		pthread_mutex_unlock(&p->env->end_mutex);
 		repeat_routine(p);
-		usleep(500);
+		philo_wait_us(p, 500);
 	}
 	return (NULL);
 }
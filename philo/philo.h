@@ -20,6 +20,10 @@
  * - Logging utilities
  * - Environment setup and cleanup functions
  * - Philosopher behavior management
+ *
+ * The `DTRACE_PROBEn(philo, ...)` calls spread over the sources are USDT
+ * probes for perf and bpftrace. Each one is a single `nop` until a tracer
+ * attaches; without `<sys/sdt.h>` they come from `compat/` and vanish.
  */
 
 #ifndef PHILO_H
@@ -32,10 +36,491 @@
 # include <sys/time.h>
 # include <string.h>
 # include <stdbool.h>
+# include <stdint.h>
+# include <stdatomic.h>
+# include <ucontext.h>
+# include <sys/sdt.h>
 
 # define LOG_BUFFER_SIZE 1024
+# define FORK_WORD_BITS 64
+# define START_DELAY_MS 5
+# define MONITOR_TICK_MS 5
+# define DEQUE_EMPTY -1
+# define DEQUE_ABORT -2
+# define CORO_STACK_SIZE 16384
+# define MAX_CPUS 1024
+# define MAX_NODES 64
+# define PHILO_STACK_RESERVE 16384
+# define PHILO_MAP_MARGIN 4096
+# define SPAWN_SLICE 256
+# define MAX_SPAWNERS 64
+# define CACHE_LINE 64
+# define SCAN_CHUNK 4096
+# define ARENA_HUGE_PAGE 2097152
+# define HIST_SUB_BITS 2
+# define HIST_BUCKETS 112
+# define LATENCY_ROWS 8
+# define LOCK_ROWS 10
+# define LIVE_MAGIC 0x4c494850
+# define LIVE_PREFIX "/philo."
+# define TRACE_MIN_MS 2
+# define GRANTS_MAGIC "philo-grants"
+# define REPLAY_POLL_US 50
+# define BATCH_MAX_ARGS 6
+# define BATCH_LINE 160
+# define SCENARIO_FIELDS 4
 
 typedef struct s_env	t_env;
+typedef struct s_crew	t_crew;
+
+/**
+ * @enum e_fork_mode
+ * @brief Selects how forks are represented and acquired.
+ *
+ * - `FORK_MUTEX`: one `pthread_mutex_t` per fork (default).
+ * - `FORK_BITMAP`: one bit per fork in an array of atomic 64-bit words.
+ */
+typedef enum e_fork_mode
+{
+	FORK_MUTEX,
+	FORK_BITMAP
+}	t_fork_mode;
+
+/**
+ * @enum e_monitor_mode
+ * @brief Selects how the monitor detects deaths.
+ *
+ * - `MONITOR_POLL`: scan every philosopher each `MONITOR_TICK_MS` (default).
+ * - `MONITOR_HEAP`: sleep until the earliest deadline in a min-heap.
+ */
+typedef enum e_monitor_mode
+{
+	MONITOR_POLL,
+	MONITOR_HEAP
+}	t_monitor_mode;
+
+/**
+ * @enum e_engine
+ * @brief Selects how philosophers are executed.
+ *
+ * - `ENGINE_THREAD`: one OS thread per philosopher (default).
+ * - `ENGINE_POOL`: philosophers are state machines advanced by a fixed pool
+ *   of worker threads.
+ * - `ENGINE_CORO`: philosophers run `routine()` as stackful coroutines
+ *   multiplexed onto a few carrier threads.
+ */
+typedef enum e_engine
+{
+	ENGINE_THREAD,
+	ENGINE_POOL,
+	ENGINE_CORO
+}	t_engine;
+
+/**
+ * @enum e_placement
+ * @brief Selects where threads and their data are placed.
+ *
+ * - `PLACE_NONE`: the kernel schedules threads freely (default).
+ * - `PLACE_NUMA`: contiguous blocks of philosophers are pinned to cores of
+ *   one NUMA node, and their slices of `philos` and `forks` are allocated
+ *   on that node.
+ */
+typedef enum e_placement
+{
+	PLACE_NONE,
+	PLACE_NUMA
+}	t_placement;
+
+/**
+ * @enum e_phase
+ * @brief State of a philosopher run by the worker pool.
+ */
+typedef enum e_phase
+{
+	PHASE_ARRIVING,
+	PHASE_THINKING,
+	PHASE_HUNGRY,
+	PHASE_EATING,
+	PHASE_SLEEPING,
+	PHASE_DONE
+}	t_phase;
+
+/**
+ * @enum e_lock_id
+ * @brief Global mutexes profiled by `--lockstat`; `LOCK_GLOBALS` is their
+ * count.
+ */
+typedef enum e_lock_id
+{
+	LOCK_MEAL,
+	LOCK_END,
+	LOCK_PRINT,
+	LOCK_LOG,
+	LOCK_GLOBALS
+}	t_lock_id;
+
+/**
+ * @struct s_opts
+ * @brief Run-time options parsed from the leading `--name=value` arguments.
+ *
+ * `quiet` is not an option: batch mode sets it so that runs print only
+ * their summary line. `forks_set` records that `--forks` was given, so
+ * that an explicit `--forks=mutex` is rejected with the engines that need
+ * the fork bitmap.
+ */
+typedef struct s_opts
+{
+	t_fork_mode		fork_mode;
+	t_monitor_mode	monitor_mode;
+	int				shards;
+	t_engine		engine;
+	int				workers;
+	t_placement		placement;
+	bool			report;
+	bool			lockstat;
+	bool			live;
+	const char		*trace;
+	int				trace_min;
+	const char		*record;
+	const char		*replay;
+	const char		*batch;
+	int				jobs;
+	const char		*scenario;
+	bool			quiet;
+	bool			forks_set;
+}	t_opts;
+
+/**
+ * @struct s_opt_setter
+ * @brief A `--name=` prefix and the parser of its value.
+ */
+typedef struct s_opt_setter
+{
+	const char	*key;
+	int			(*set)(t_opts *opts, const char *val);
+}	t_opt_setter;
+
+/**
+ * @struct s_topology
+ * @brief CPU topology read from sysfs.
+ *
+ * `cpus` lists the CPUs this process may run on, grouped by NUMA node:
+ * group `k` is node `node_ids[k]` and spans `cpus[node_first[k]]` up to
+ * `cpus[node_first[k + 1] - 1]`. `cpu_node` maps a CPU id back to its
+ * group, or -1.
+ */
+typedef struct s_topology
+{
+	int	cpus[MAX_CPUS];
+	int	num_cpus;
+	int	node_ids[MAX_NODES];
+	int	node_first[MAX_NODES + 1];
+	int	num_nodes;
+	int	cpu_node[MAX_CPUS];
+}	t_topology;
+
+/**
+ * @enum e_arena_backing
+ * @brief Pages backing the arena.
+ *
+ * - `ARENA_PAGES`: base pages.
+ * - `ARENA_THP`: base pages marked for transparent huge pages.
+ * - `ARENA_HUGETLB`: reserved huge pages.
+ */
+typedef enum e_arena_backing
+{
+	ARENA_PAGES,
+	ARENA_THP,
+	ARENA_HUGETLB
+}	t_arena_backing;
+
+/**
+ * @struct s_arena
+ * @brief One mapping holding `t_env`, the philosophers and the forks.
+ *
+ * Regions are carved in order from `base`; `used` is the carved size.
+ * A `keep` arena belongs to a batch runner, which reuses it for its next
+ * run, so `free_env()` leaves it mapped.
+ */
+typedef struct s_arena
+{
+	void			*base;
+	size_t			size;
+	size_t			used;
+	t_arena_backing	backing;
+	bool			keep;
+}	t_arena;
+
+/**
+ * @struct s_fork_table
+ * @brief Lock-free fork table with one bit per fork.
+ *
+ * A set bit means the fork is taken. Waiters park on a futex keyed by the
+ * 32-bit half of the word holding the fork, and `waiters` counts parked
+ * threads per word so that releases only enter the kernel when needed.
+ */
+typedef struct s_fork_table
+{
+	_Atomic uint64_t	*words;
+	atomic_int			*waiters;
+	int					num_words;
+}	t_fork_table;
+
+/**
+ * @struct s_deadline_heap
+ * @brief Indexed min-heap of philosopher death deadlines.
+ *
+ * Covers the `size` philosophers starting at index `base`. `heap` holds
+ * local indices ordered by `deadline`, and `pos` maps a local index back to
+ * its heap slot so that its deadline can be updated in place. The monitor
+ * sleeps on `cond` until the earliest deadline.
+ */
+typedef struct s_deadline_heap
+{
+	int				*heap;
+	int				*pos;
+	long			*deadline;
+	int				base;
+	int				size;
+	pthread_mutex_t	mutex;
+	pthread_cond_t	cond;
+}	t_deadline_heap;
+
+/**
+ * @brief Kernel returning the first philosopher in `lo` to `hi - 1` whose
+ * deadline is below `limit`, or `hi` if there is none.
+ */
+typedef int				(*t_scan_fn)(const long *deadline, int lo, int hi,
+						long limit);
+
+/**
+ * @struct s_scan_kernel
+ * @brief A scan kernel and the instruction set it uses.
+ */
+typedef struct s_scan_kernel
+{
+	const char	*name;
+	t_scan_fn	fn;
+}	t_scan_kernel;
+
+/**
+ * @struct s_monitor_shard
+ * @brief One monitor thread and the range of philosophers it watches.
+ *
+ * Each shard owns philosophers `lo` to `hi - 1`, its own deadline heap in
+ * heap mode, and scan timing counters written only by its own thread.
+ */
+typedef struct s_monitor_shard
+{
+	t_env			*env;
+	int				lo;
+	int				hi;
+	pthread_t		thread;
+	bool			created;
+	t_deadline_heap	heap;
+	long			scans;
+	long			scan_total_us;
+	long			scan_max_us;
+}	t_monitor_shard;
+
+/**
+ * @struct s_run_deque
+ * @brief Chase-Lev work-stealing deque of runnable philosophers.
+ *
+ * Only the owning worker pushes and takes at `bottom`; other workers steal
+ * at `top`. The buffer never grows: a philosopher is queued at most once,
+ * so `mask + 1` slots (a power of two of at least `num_philo`) suffice.
+ */
+typedef struct s_run_deque
+{
+	atomic_long	top;
+	atomic_long	bottom;
+	atomic_int	*buf;
+	long		mask;
+}	t_run_deque;
+
+/**
+ * @struct s_pool_worker
+ * @brief One worker thread of the pool, its run deque and its timers.
+ *
+ * The worker is home to philosophers `lo` to `hi - 1`: their next wake-up
+ * times (`LONG_MAX` when there is none) live in `timers`, on whose
+ * condition variable the worker sleeps while `idle`. The counters are
+ * written only by the worker itself.
+ */
+typedef struct s_pool_worker
+{
+	t_env			*env;
+	int				index;
+	int				lo;
+	int				hi;
+	pthread_t		thread;
+	t_run_deque		deque;
+	t_deadline_heap	timers;
+	atomic_bool		idle;
+	long			steps;
+	long			steals;
+	long			busy_us;
+}	t_pool_worker;
+
+/**
+ * @struct s_pool
+ * @brief Worker pool that runs philosophers as state machines.
+ *
+ * Philosopher `i` has its timers on worker `i / block`. `park_mutex`
+ * guards parking of philosophers that wait for forks. A philosopher is
+ * always in exactly one place: running on a worker, queued in a deque,
+ * waiting for a timer, or parked waiting for forks.
+ */
+typedef struct s_pool
+{
+	t_pool_worker	*workers;
+	int				num_workers;
+	int				block;
+	int				created;
+	pthread_mutex_t	park_mutex;
+}	t_pool;
+
+/**
+ * @struct s_coro_ctx
+ * @brief Suspended context of a coroutine or of a carrier's scheduler.
+ *
+ * On x86-64 `coro_switch()` pushes the callee-saved registers on the
+ * suspended stack, so only the stack pointer is kept and a switch never
+ * enters the kernel. Elsewhere it falls back to a `ucontext_t`.
+ */
+# if defined(__x86_64__)
+typedef struct s_coro_ctx
+{
+	void	*sp;
+}	t_coro_ctx;
+# else
+typedef struct s_coro_ctx
+{
+	ucontext_t	uc;
+}	t_coro_ctx;
+# endif
+
+/**
+ * @struct s_carrier
+ * @brief OS thread that runs a block of philosopher coroutines.
+ *
+ * The carrier owns philosophers `lo` to `hi - 1` and resumes each of them
+ * from `sched`, its scheduler context, once its wake-up time has passed.
+ * `switches` counts the resumes and is written only by the carrier.
+ * `kick` is a futex word bumped whenever one of its parked coroutines is
+ * made runnable, so that the carrier does not sleep past it.
+ */
+typedef struct s_carrier
+{
+	t_env				*env;
+	int					lo;
+	int					hi;
+	pthread_t			thread;
+	t_coro_ctx			sched;
+	long				switches;
+	_Atomic uint32_t	kick;
+}	t_carrier;
+
+/**
+ * @struct s_coro
+ * @brief A philosopher running as a stackful coroutine.
+ *
+ * `ctx` is the suspended context on the philosopher's own stack. The
+ * carrier resumes it once `wake_at` (in microseconds) has passed; a
+ * coroutine parked on its forks waits with `LONG_MAX` until a neighbour
+ * sets it to 0. `done` is set when `routine()` returns.
+ */
+typedef struct s_coro
+{
+	t_coro_ctx	ctx;
+	t_carrier	*carrier;
+	atomic_long	wake_at;
+	bool		done;
+}	t_coro;
+
+/**
+ * @struct s_coro_sched
+ * @brief Coroutines, their stacks and the carrier threads running them.
+ *
+ * All stacks live in one mapping of `slot`-sized slots, each made of a
+ * guard page followed by `CORO_STACK_SIZE` bytes of stack. `park_mutex`
+ * guards parking of coroutines that wait for forks, as in `t_pool`.
+ */
+typedef struct s_coro_sched
+{
+	t_coro			*coros;
+	t_carrier		*carriers;
+	char			*stacks;
+	size_t			slot;
+	size_t			stacks_len;
+	int				num_carriers;
+	int				block;
+	int				created;
+	pthread_mutex_t	park_mutex;
+}	t_coro_sched;
+
+/**
+ * @struct s_spawner
+ * @brief One slice of startup work, run by its own spawner thread.
+ *
+ * Startup work on philosophers `lo` to `hi - 1` runs in parallel with the
+ * other slices. `done` counts the philosophers finished before a failure,
+ * and `status` is EXIT_FAILURE if one occurred.
+ */
+typedef struct s_spawner
+{
+	t_env		*env;
+	int			lo;
+	int			hi;
+	int			done;
+	int			status;
+	bool		created;
+	pthread_t	thread;
+}	t_spawner;
+
+/**
+ * @enum e_crew_state
+ * @brief State of a crew thread, which is also the word it parks on.
+ */
+typedef enum e_crew_state
+{
+	CREW_IDLE,
+	CREW_BUSY,
+	CREW_EXIT
+}	t_crew_state;
+
+/**
+ * @struct s_crew_member
+ * @brief One thread of a crew and the task it was handed.
+ */
+typedef struct s_crew_member
+{
+	pthread_t	thread;
+	void		*(*fn)(void *);
+	void		*arg;
+	atomic_uint	state;
+	t_crew		*crew;
+}	t_crew_member;
+
+/**
+ * @struct s_crew
+ * @brief The threads one `--batch` runner keeps across its runs.
+ *
+ * Members are created the first time a run needs them, up to `capacity`,
+ * and park between runs. `used` counts the members handed a task by the
+ * current run. With `repin`, a member returns to its original CPU mask
+ * after a task that may have pinned it.
+ */
+typedef struct s_crew
+{
+	t_crew_member	*members;
+	int				capacity;
+	int				created;
+	int				used;
+	bool			repin;
+	pthread_attr_t	attr;
+}	t_crew;
 
 /**
  * @struct s_log_entry
@@ -67,29 +552,355 @@ typedef struct s_log_buffer
 	pthread_mutex_t	mutex;
 }	t_log_buffer;
 
+/**
+ * @struct s_hist
+ * @brief Log-bucketed histogram of durations in microseconds.
+ *
+ * Values below `2^HIST_SUB_BITS` get a bucket each (values of at most 0
+ * share bucket 0). Above that, every power of two is split into
+ * `2^HIST_SUB_BITS` equal buckets, so a bucket is never wider than a
+ * quarter of its lower bound; the last bucket takes everything above.
+ * `min` and `max` are exact.
+ */
+typedef struct s_hist
+{
+	int		counts[HIST_BUCKETS];
+	long	n;
+	long	min;
+	long	max;
+}	t_hist;
+
+/**
+ * @struct s_latency
+ * @brief Latency histograms of one philosopher, kept for `--report`.
+ *
+ * - `wait`: time from becoming hungry to holding both forks
+ * - `interval`: time between the starts of two meals (the first one is
+ *   counted from the simulation start)
+ * - `margin`: time left before starving when a meal starts, if any
+ * - `overshoot`: how late a meal started after the deadline otherwise, so
+ *   that the two together form a signed histogram of the margin (see
+ *   `margin_pct()`)
+ *
+ * Only the philosopher itself writes its entry, so no locking is needed;
+ * it is read once every philosopher has stopped.
+ */
+typedef struct s_latency
+{
+	t_hist	wait;
+	t_hist	interval;
+	t_hist	margin;
+	t_hist	overshoot;
+	long	hungry_at;
+	long	meal_at;
+}	t_latency;
+
+/**
+ * @struct s_lock_stat
+ * @brief Acquisition counters of one mutex, kept by `--lockstat`.
+ *
+ * An acquisition is contended when `pthread_mutex_trylock()` failed; only
+ * those are timed, in nanoseconds.
+ */
+typedef struct s_lock_stat
+{
+	long	acquired;
+	long	contended;
+	long	wait_ns;
+	long	max_ns;
+}	t_lock_stat;
+
+/**
+ * @struct s_lock_block
+ * @brief One thread's counters for the global mutexes.
+ *
+ * Each thread gets its own block the first time it takes a profiled lock
+ * and pushes it on the lock-free list `env->lock_blocks`, which is walked
+ * once the threads have been joined.
+ */
+typedef struct s_lock_block
+{
+	t_lock_stat			locks[LOCK_GLOBALS];
+	struct s_lock_block	*next;
+}	t_lock_block;
+
+/**
+ * @enum e_live_state
+ * @brief Philosopher state published by `--live`, from its last status.
+ */
+typedef enum e_live_state
+{
+	LIVE_WAITING,
+	LIVE_FORK,
+	LIVE_EATING,
+	LIVE_SLEEPING,
+	LIVE_THINKING
+}	t_live_state;
+
+/**
+ * @struct s_live_header
+ * @brief Start of the `--live` shared memory segment.
+ *
+ * Written at setup, except `start_time` (set when the start gate opens),
+ * `died` (the number of the philosopher that died, or 0) and `ended`
+ * (set once every thread has stopped). The philosophers' slots follow at
+ * the next cache line.
+ */
+typedef struct s_live_header
+{
+	uint32_t	magic;
+	int			num_philo;
+	long		die_time;
+	long		eat_time;
+	long		sleep_time;
+	int			meals_limit;
+	bool		fork_stats;
+	atomic_long	start_time;
+	atomic_int	died;
+	atomic_int	ended;
+}	t_live_header;
+
+/**
+ * @struct s_live_slot
+ * @brief Seqlocked snapshot of one philosopher in the `--live` segment.
+ *
+ * Only the philosopher writes its slot: `seq` is odd while it does, so a
+ * reader copies the slot and retries if `seq` was odd or changed.
+ * `last_meal` is the absolute start of the last meal in milliseconds (0
+ * before the first one). The fork counters come from `--lockstat` and
+ * stay 0 without it. `die_time` and `meals_limit` are the philosopher's
+ * own, which `--scenario` may set apart from the header's; they are
+ * written once before the start gate opens (see `live_timings()`).
+ */
+typedef struct s_live_slot
+{
+	atomic_uint	seq;
+	int			state;
+	int			meals;
+	long		last_meal;
+	long		contended;
+	long		wait_ns;
+	long		die_time;
+	int			meals_limit;
+}	t_live_slot;
+
+/**
+ * @enum e_trace_kind
+ * @brief Interval kinds written by `--trace`, in the order of their names.
+ */
+typedef enum e_trace_kind
+{
+	TRACE_THINK,
+	TRACE_WAIT,
+	TRACE_EAT,
+	TRACE_SLEEP
+}	t_trace_kind;
+
+/**
+ * @struct s_trace_track
+ * @brief The `--trace` state of one philosopher.
+ *
+ * `kind` is the interval in progress, begun at `since`; `hungry` is when
+ * the philosopher last started thinking. Finished intervals are merged
+ * into the slice `slice` (-1 when there is none), which covers `from` to
+ * `to` and is written once an interval of another kind, at least
+ * `trace_min` long, ends. All times are in ms from `start_time`.
+ */
+typedef struct s_trace_track
+{
+	int		kind;
+	long	since;
+	long	hungry;
+	int		slice;
+	long	from;
+	long	to;
+}	t_trace_track;
+
+/**
+ * @struct s_trace
+ * @brief Chrome trace-event writer of `--trace`.
+ *
+ * Only the log flusher touches it during the run, apart from `dead` and
+ * `dead_at`, which the monitor that detects the death sets. `fork_by`
+ * and `fork_at` keep the last philosopher that ate with each fork and
+ * when, to draw the fork handoffs. `batch` holds a copy of the last
+ * flushed log entries, which are traced once the log buffer is unlocked.
+ */
+typedef struct s_trace
+{
+	FILE			*out;
+	int				num_philo;
+	long			min_ms;
+	t_trace_track	*tracks;
+	int				*fork_by;
+	long			*fork_at;
+	long			flows;
+	long			last;
+	int				dead;
+	long			dead_at;
+	t_log_entry		*batch;
+	int				batch_count;
+}	t_trace;
+
+/**
+ * @struct s_grant_log
+ * @brief The fork grants of one philosopher, for `--record` and `--replay`.
+ *
+ * Every meal adds two tickets: the place of the meal in the grant order
+ * of the philosopher's own fork, then in that of its right fork. Only the
+ * philosopher appends to its log; `next` is the replay cursor.
+ */
+typedef struct s_grant_log
+{
+	long	*tickets;
+	long	count;
+	long	cap;
+	long	next;
+}	t_grant_log;
+
+/**
+ * @struct s_batch_run
+ * @brief One configuration of a `--batch` file.
+ *
+ * `av` points into the loaded file, whose lines were split in place, and
+ * is laid out like the `argv` of a single run (`av[0]` is the program).
+ */
+typedef struct s_batch_run
+{
+	char	*av[BATCH_MAX_ARGS];
+	int		ac;
+	bool	valid;
+}	t_batch_run;
+
+/**
+ * @struct s_batch
+ * @brief The runs of `--batch` and the cursor the runners share.
+ *
+ * Each of the `--jobs` runners claims the next run with `next`, so runs
+ * start in file order but may finish out of order. `max_philo` sizes the
+ * arena every runner maps once and reuses.
+ */
+typedef struct s_batch
+{
+	t_opts		opts;
+	char		*text;
+	t_batch_run	*runs;
+	int			count;
+	int			max_philo;
+	atomic_int	next;
+	atomic_int	failed;
+}	t_batch;
+
+/**
+ * @enum e_dist_kind
+ * @brief How a `--scenario` rule sets one field.
+ *
+ * - `DIST_KEEP`: leaves the value set before (`-`).
+ * - `DIST_FIXED`: sets `a` (`N`; `none` is -1, for the meal limit only).
+ * - `DIST_UNIFORM`: draws an integer from `a` to `b` (`A..B`).
+ * - `DIST_NORMAL`: draws around mean `a` with standard deviation `b`
+ *   (`A~B`), rounded and clamped at 0.
+ */
+typedef enum e_dist_kind
+{
+	DIST_KEEP,
+	DIST_FIXED,
+	DIST_UNIFORM,
+	DIST_NORMAL
+}	t_dist_kind;
+
+/**
+ * @struct s_dist
+ * @brief One field of a `--scenario` rule.
+ */
+typedef struct s_dist
+{
+	t_dist_kind	kind;
+	long		a;
+	long		b;
+}	t_dist;
+
+/**
+ * @struct s_rule
+ * @brief A `--scenario` line: philosophers `lo` to `hi` (counted from 1)
+ * and their die, eat and sleep times and meal limit.
+ */
+typedef struct s_rule
+{
+	int		lo;
+	int		hi;
+	t_dist	field[SCENARIO_FIELDS];
+}	t_rule;
+
+/**
+ * @struct s_scenario
+ * @brief The rules of a `--scenario` file, applied in file order.
+ *
+ * Every draw is a hash of `seed`, the rule and the philosopher, so the
+ * timings do not depend on which thread initializes which philosopher.
+ */
+typedef struct s_scenario
+{
+	t_rule		*rules;
+	int			count;
+	uint64_t	seed;
+}	t_scenario;
+
+/**
+ * @struct s_config
+ * @brief Simulation parameters from the command line.
+ *
+ * These are the defaults every philosopher starts from, which
+ * `--scenario` may override per philosopher (see `t_philo`).
+ *
+ * Written once by `init_env()` and only read afterwards. It is the first
+ * member of `t_env`, so it sits at the start of the arena, on a cache line
+ * that no thread writes during the simulation.
+ */
+typedef struct s_config
+{
+	int		num_philo;
+	long	die_time;
+	long	eat_time;
+	long	sleep_time;
+	int		meals_limit;
+}	t_config;
+
 /**
  * @struct s_philo
  * @brief Represents a single philosopher in the simulation.
  *
+ * Only cold, mostly read-only state lives here. The meal counter, last
+ * meal time and death deadline are kept in the dense `meals`, `last_meal`
+ * and `deadline` arrays of `t_env`.
+ *
  * Each philosopher has:
  * - A unique ID
- * - A meal counter
  * - A thread to run its routine
- * - Timing constraints (die, eat, sleep times)
  * - A reference to the shared environment (`t_env`)
+ * - Its own timings and meal limit: those of the command line, or drawn
+ *   from the `--scenario` file (-1 means no meal limit)
+ * - Its start lag and first meal time for `--report`
+ * - Its state machine phase and current worker when run by the worker pool
+ * - Whether it is parked waiting for forks, in the pool and coroutine
+ *   engines
+ * - Its coroutine when run by the coroutine engine, otherwise NULL
  */
 typedef struct s_philo
 {
 	int			id;
-	int			meals;
-	long		last_meal;
 	pthread_t	thread;
 	t_env		*env;
-	int			num_philo;
 	long		die_time;
 	long		eat_time;
 	long		sleep_time;
 	int			meals_limit;
+	long		start_lag;
+	long		first_meal;
+	t_phase		phase;
+	bool		waiting;
+	int			worker;
+	t_coro		*coro;
 }	t_philo;
 
 /**
@@ -97,71 +908,309 @@ typedef struct s_philo
  * @brief Global environment for the philosopher simulation.
  *
  * Contains:
- * - Simulation parameters (timing, number of philosophers)
+ * - Simulation parameters (timing, number of philosophers) and options
+ * - The hot per-philosopher state as parallel arrays: last meal time, death
+ *   deadline (the first millisecond at which the philosopher counts as
+ *   dead, LONG_MAX once it ate its meal limit if `mixed_limits` is set)
+ *   and meal count, indexed by philosopher ID
+ * - The rules of `--scenario`, otherwise NULL, and whether they gave the
+ *   philosophers different meal limits
+ * - The per-philosopher latency histograms of `--report`, otherwise NULL
  * - Shared mutexes for synchronization
- * - Fork mutexes for philosophers to use
+ * - Fork mutexes or the fork bitmap for philosophers to use
  * - A logger buffer for structured output
+ * - The start gate (ready counter and futex word) for a synchronized start
+ * - The count of philosophers that reached the meal limit
+ * - The worker pool when philosophers run as state machines
+ * - The coroutine scheduler when philosophers run as coroutines
+ * - The monitor shards, their scan kernel, the measured death detection
+ *   latency and which philosopher died when (`dead` counts from 1)
+ * - The CPU topology and the fork handoff counters of `--report`
+ * - The lock counters of `--lockstat`: two per philosopher for the forks it
+ *   takes, and per-thread blocks for the global mutexes
+ * - The shared memory segment of `--live`, otherwise NULL
+ * - The trace writer of `--trace`, otherwise NULL
+ * - The per-fork grant counters and per-philosopher grant logs of
+ *   `--record` and `--replay`, otherwise NULL
+ * - Startup timing: launch time, spawner count and thread creation time
+ * - The arena holding the environment, philosophers and forks
+ * - The thread crew of a `--batch` runner, otherwise NULL
  * - Flags indicating thread creation status
  */
 typedef struct s_env
 {
-	int				num_philo;
-	long			die_time;
-	long			eat_time;
-	long			sleep_time;
-	int				meals_limit;
+	t_config		cfg;
+	t_opts			opts;
+	long			*last_meal;
+	long			*deadline;
+	int				*meals;
+	t_scenario		*scenario;
+	bool			mixed_limits;
+	t_latency		*lat;
 	int				ended;
 	long			start_time;
 	pthread_mutex_t	*forks;
+	t_fork_table	fork_table;
+	t_pool			*pool;
+	t_coro_sched	*coro;
+	t_monitor_shard	*shards;
+	int				num_shards;
+	int				shard_size;
+	t_scan_kernel	scan;
+	long			death_latency;
+	int				dead;
+	long			dead_at;
+	t_topology		topo;
+	int				*fork_node;
+	atomic_long		handoffs;
+	atomic_long		cross_handoffs;
+	t_lock_stat		*fork_stats;
+	pthread_key_t	lock_key;
+	bool			lock_key_created;
+	_Atomic(t_lock_block *)	lock_blocks;
+	t_live_header	*live;
+	t_live_slot		*live_slots;
+	size_t			live_size;
+	char			live_name[32];
+	t_trace			*trace;
+	atomic_long		*grants;
+	t_grant_log		*grant_logs;
+	long			launch_time;
+	int				num_spawners;
+	long			spawn_us;
+	t_arena			arena;
+	t_crew			*crew;
 	t_philo			*philos;
 	pthread_mutex_t	print_mutex;
 	pthread_mutex_t	meal_mutex;
-	pthread_mutex_t	start_mutex;
 	pthread_mutex_t	end_mutex;
 	t_log_buffer	log_buffer;
 	bool			t_philos_created;
 	bool			t_logger_created;
-	bool			t_mon_created;
+	int				start_expected;
+	atomic_int		ready_count;
+	atomic_uint		start_gate;
+	atomic_int		satiated;
 }	t_env;
 
 /* ========================== Function Prototypes ========================== */
 
 /* Initialization */
+void	init_opts(t_opts *opts);
+int		parse_options(t_opts *opts, int ac, char **av);
+void	print_usage(void);
 bool	validate_args(int ac, char **av);
-void	init_program(t_env **env, int ac, char **av);
+void	init_program(t_env **env, t_opts *opts, int ac, char **av);
+int		opt_choice(const char *val, const char *const *names);
+int		set_fork_mode(t_opts *opts, const char *val);
+int		set_monitor_mode(t_opts *opts, const char *val);
+int		alloc_forks(t_env *env);
+int		alloc_shards(t_env *env);
+int		set_shards(t_opts *opts, const char *val);
+int		set_engine(t_opts *opts, const char *val);
+int		set_workers(t_opts *opts, const char *val);
+int		set_placement(t_opts *opts, const char *val);
+int		set_flag(t_opts *opts, const char *arg);
+int		opt_number(const char *val, int *out);
+int		set_trace(t_opts *opts, const char *val);
+int		set_trace_min(t_opts *opts, const char *val);
+int		set_record(t_opts *opts, const char *val);
+int		set_replay(t_opts *opts, const char *val);
+int		set_batch(t_opts *opts, const char *val);
+int		set_jobs(t_opts *opts, const char *val);
+int		set_scenario(t_opts *opts, const char *val);
+int		alloc_heap(t_deadline_heap *h, int base, int size);
+void	heap_fill(t_deadline_heap *h, long key);
+void	heap_build(t_deadline_heap *h, const long *keys);
 int		init_env(t_env *env, int ac, char **av);
-void	join_threads(t_env *env, pthread_t mon, pthread_t logger_thread);
+void	join_threads(t_env *env, pthread_t logger_thread);
 
 /* Mutex Initialization */
 int		init_print_mutex(t_env *env);
 int		init_meal_mutex(t_env *env);
-int		init_start_mutex(t_env *env);
 int		init_end_mutex(t_env *env);
 int		init_log_buffer_mutex(t_env *env);
-int		init_forks_mutex(t_env *env);
+int		init_forks_mutex(t_env *env, int lo, int hi);
 
 /* Thread Management */
 void	*log_flusher(void *arg);
+void	flush_log_entries(t_env *env, int log_count);
 void	*monitor(void *arg);
+void	*monitor_heap(t_monitor_shard *s);
+void	record_scan(t_monitor_shard *s, long us);
+int		scan_kernels(t_scan_kernel *out);
+t_scan_kernel	select_scan(void);
+int		check_death(t_env *env, int i);
+void	announce_death(t_env *env, int i, long now, long deadline);
+int		check_full(t_env *env);
+int		should_terminate(t_env *env);
+void	count_meal(t_philo *p);
+void	start_meal(t_philo *p);
+void	heap_set_key(t_deadline_heap *h, int i, long key);
+void	heap_wait_until(t_deadline_heap *h, long ms);
+void	deadline_heap_update(t_env *env, int id, long deadline);
+void	wake_monitors(t_env *env);
 void	*routine(void *arg);
-int		start_threads(t_env *env, pthread_t *mon, pthread_t *logger_thread);
+int		start_threads(t_env *env, pthread_t *logger_thread);
+int		create_monitor_threads(t_env *env);
+void	join_monitor_threads(t_env *env);
+
+/* Arena */
+int		arena_map(t_arena *a, const t_opts *opts, int n);
+void	*arena_carve(t_arena *a, size_t size);
+void	arena_prefault(t_arena *a);
+
+/* Startup */
+int		init_philos_forks(t_env *env);
+int		run_spawners(t_env *env, t_spawner *sp, void *(*fn)(void *));
+bool	spawners_failed(t_spawner *sp, int n);
+void	report_first_meal(t_env *env);
+
+/* Thread Crew */
+int		crew_init(t_crew *c, const t_opts *opts, int capacity);
+int		start_thread(t_env *env, pthread_t *thread, void *(*fn)(void *),
+			void *arg);
+void	*crew_slice(void *arg);
+void	crew_wait(t_crew *c);
+void	crew_stop(t_crew *c);
+
+/* Thread Attributes */
+size_t	philo_stack_size(void);
+int		init_thread_attr(long threads, pthread_attr_t *attr);
+void	report_memory(t_env *env);
+
+/* Start Gate */
+void	announce_ready(t_env *env);
+long	await_start(t_env *env);
+void	open_start_gate(t_env *env);
+void	release_start_gate(t_env *env, long start_time);
+
+/* Worker Pool */
+int		alloc_pool(t_env *env);
+void	pool_seed(t_env *env);
+int		create_pool_workers(t_env *env);
+void	join_pool_workers(t_env *env);
+void	free_pool(t_env *env);
+void	pool_wake_idle(t_pool *pool, t_pool_worker *self);
+void	pool_wake_all(t_env *env);
+void	pool_schedule(t_env *env, int id, long at);
+void	*pool_worker(void *arg);
+bool	pool_try_eat(t_philo *p);
+void	pool_wake_neighbours(t_env *env, int id);
+void	philo_step(t_philo *p);
+int		pool_size(t_env *env);
+int		alloc_deque(t_run_deque *q, int size);
+void	deque_push(t_run_deque *q, int id);
+int		deque_take(t_run_deque *q);
+int		deque_steal(t_run_deque *q);
+long	deque_size(t_run_deque *q);
+
+/* Placement */
+int		load_topology(t_topology *t);
+int		alloc_placement(t_env *env);
+void	place_thread(t_env *env, pthread_t thread, int i);
+void	note_handoff(t_philo *p);
+void	report_placement(t_env *env);
+
+/* Lock Profiling */
+int		alloc_lockstat(t_env *env);
+void	stat_lock(t_env *env, pthread_mutex_t *m, t_lock_id id);
+void	stat_lock_fork(t_philo *p, int fork);
+void	report_locks(t_env *env);
+
+/* Live Stats */
+int		alloc_live(t_env *env);
+void	free_live(t_env *env);
+void	live_publish(t_philo *p, const char *status, long timestamp);
+void	live_died(t_env *env, int id);
+void	live_timings(t_env *env, int lo, int hi);
+
+/* Trace Export */
+int		alloc_trace(t_env *env);
+void	free_trace(t_env *env);
+void	trace_died(t_env *env, int id, long timestamp);
+void	trace_entries(t_trace *t, const t_log_entry *entries, int count);
+void	trace_interval(t_trace *t, int id, long to);
+void	trace_slice(t_trace *t, int id);
+
+/* Grant Record and Replay */
+int		alloc_grants(t_env *env);
+void	free_grants(t_env *env);
+int		load_grants(t_env *env);
+void	grant_record(t_philo *p);
+bool	replay_turn(t_philo *p);
+void	replay_wait(t_philo *p);
+char	*read_file(const char *path);
+char	*next_line(char **s);
+int		count_lines(const char *s);
+char	*next_token(char **s);
+
+/* Batch Mode */
+int		load_batch(t_batch *b);
+int		run_batch(t_opts *opts);
+void	batch_summary(t_batch *b, int i, t_env *env);
+
+/* Scenarios */
+int		load_scenario(t_env *env);
+int		parse_rule(t_scenario *sc, char *line);
+void	apply_scenario(t_env *env, t_philo *p);
+void	free_scenario(t_env *env);
+void	scenario_limits(t_env *env);
+
+/* Latency Histograms */
+void	latency_hungry(t_philo *p);
+void	latency_meal(t_philo *p);
+long	hist_upper(int b);
+long	hist_pct(const t_hist *h, long permille);
+long	margin_min(const t_latency *l);
+long	margin_pct(const t_latency *l, long permille);
+void	report_latency(t_env *env);
+
+/* Coroutine Engine */
+int		alloc_coro(t_env *env);
+void	free_coro(t_env *env);
+int		create_coro_carriers(t_env *env);
+void	join_coro_carriers(t_env *env);
+void	coro_entry(t_philo *p);
+void	coro_switch(t_coro_ctx *from, t_coro_ctx *to);
+int		coro_ctx_init(t_coro_ctx *ctx, char *stack, size_t size, t_philo *p);
+void	coro_take_forks(t_philo *p);
+void	coro_wake_neighbours(t_env *env, int id);
+void	philo_sleep(t_philo *p, long ms);
+void	philo_wait_us(t_philo *p, long us);
 
 /* Philosopher Routine */
 void	put_forks(t_philo *p);
 void	take_forks(t_philo *p);
 void	precise_sleep(long ms);
 long	get_time(void);
+long	get_time_us(void);
+
+/* Fork Bitmap */
+void	bitmap_take_forks(t_philo *p);
+void	bitmap_put_forks(t_philo *p);
+bool	bitmap_try_take_forks(t_philo *p, bool straddle);
+long	futex_wait(void *addr, uint32_t expected);
+long	futex_wait_us(void *addr, uint32_t expected, long us);
+void	futex_wake(void *addr, int count);
+uint32_t	*futex_half(void *word, int high);
 
 /* Memory Management */
 void	free_env(t_env *env);
 void	destroy_mutexes(t_env *env);
 void	free_all(t_env *env);
+void	free_shards(t_env *env);
+void	free_lockstat(t_env *env);
 
 /* Utility Functions */
 void	ft_strncpy(char *dest, const char *src, size_t n);
 size_t	ft_strlen(const char *s);
+int		ft_strncmp(const char *s1, const char *s2, size_t n);
 int		ft_atoi(const char *str);
 void	print_error(char *msg);
 void	print_status(t_philo *p, const char *status);
+void	buffered_print(t_env *env, long timestamp, int id,
+			const char *status);
+void	print_report(t_env *env);
 
 #endif
@@ -43,6 +43,26 @@ long	get_time(void)
 	return (tv.tv_sec * 1000 + tv.tv_usec / 1000);
 }
 
+/**
+ * @brief Retrieves the current timestamp in microseconds.
+ *
+ * Uses the same clock as `get_time()`, so both can be compared after
+ * scaling.
+ *
+ * @return The current time in microseconds, or -1 if `gettimeofday()` fails.
+ */
+long	get_time_us(void)
+{
+	struct timeval	tv;
+
+	if (gettimeofday(&tv, NULL) != 0)
+	{
+		print_error("Error: get_time_us: gettimeofday failed.\n");
+		return (-1);
+	}
+	return (tv.tv_sec * 1000000 + tv.tv_usec);
+}
+
 /**
  * @brief Sleeps for a precise duration in milliseconds.
  *
@@ -70,39 +90,51 @@ void	precise_sleep(long ms)
  * Implements a strategy to reduce deadlocks:
  * - Even-indexed philosophers pick up their left fork first.
  * - Odd-indexed philosophers pick up their right fork first.
+ * In bitmap mode the forks are taken by `bitmap_take_forks()` instead, and
+ * a coroutine takes them with `coro_take_forks()` so that it never blocks
+ * its carrier thread. The time spent waiting goes to the latency
+ * histograms of `--report`. Under `--replay` the philosopher first waits
+ * for its recorded turn at both forks, and once it holds them it takes
+ * their grant tickets for `--record` (see `grants.c`).
  *
  * Thread safety:
- * - Uses `pthread_mutex_lock()` to prevent race conditions when accessing forks.
+ * - Uses the fork mutexes (through `stat_lock_fork()`) to prevent race
+ *   conditions when accessing forks.
  *
  * @param p Pointer to the philosopher structure.
  */
 void	take_forks(t_philo *p)
 {
-	int	left;
-	int	right;
+	int	first;
+	int	second;
 
-	left = p->id;
-	right = (p->id + 1) % p->num_philo;
-	if (!(p->id & 1))
-	{
-		pthread_mutex_lock(&p->env->forks[left]);
-		print_status(p, "has taken a fork");
-		pthread_mutex_lock(&p->env->forks[right]);
-		print_status(p, "has taken a fork");
-	}
+	latency_hungry(p);
+	DTRACE_PROBE1(philo, fork_acquire_begin, p->id + 1);
+	replay_wait(p);
+	if (p->coro)
+		coro_take_forks(p);
+	else if (p->env->opts.fork_mode == FORK_BITMAP)
+		bitmap_take_forks(p);
 	else
 	{
-		pthread_mutex_lock(&p->env->forks[right]);
+		first = (p->id + (p->id & 1)) % p->env->cfg.num_philo;
+		second = (p->id + !(p->id & 1)) % p->env->cfg.num_philo;
+		stat_lock_fork(p, first);
 		print_status(p, "has taken a fork");
-		pthread_mutex_lock(&p->env->forks[left]);
+		stat_lock_fork(p, second);
 		print_status(p, "has taken a fork");
 	}
+	grant_record(p);
+	DTRACE_PROBE1(philo, fork_acquire_end, p->id + 1);
+	latency_meal(p);
 }
 
 /**
  * @brief Handles the action of a philosopher releasing both forks after eating.
  *
  * Unlocks the mutexes associated with the philosopher's left and right forks.
+ * In bitmap mode the bits are cleared instead, and a coroutine then makes
+ * its parked neighbours runnable.
  *
  * Thread safety:
  * - Uses `pthread_mutex_unlock()` to safely release fork resources.
@@ -111,6 +143,14 @@ void	take_forks(t_philo *p)
  */
 void	put_forks(t_philo *p)
 {
+	if (p->env->opts.fork_mode == FORK_BITMAP)
+	{
+		bitmap_put_forks(p);
+		if (p->coro)
+			coro_wake_neighbours(p->env, p->id);
+		return ;
+	}
+	DTRACE_PROBE1(philo, fork_release, p->id + 1);
 	pthread_mutex_unlock(&p->env->forks[p->id]);
-	pthread_mutex_unlock(&p->env->forks[(p->id + 1) % p->num_philo]);
+	pthread_mutex_unlock(&p->env->forks[(p->id + 1) % p->env->cfg.num_philo]);
 }
@@ -0,0 +1,168 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   placement.c                                        :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: imunaev- <imunaev-@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/03/23 15:26:11 by imunaev-          #+#    #+#             */
+/*   Updated: 2025/03/23 15:26:11 by imunaev-         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file placement.c
+ * @brief NUMA-aware placement of threads and philosopher data.
+ *
+ * Philosopher `i` is placed on CPU `cpus[i * num_cpus / num_philo]` of the
+ * topology. Since CPUs are grouped by node, contiguous blocks of
+ * philosophers, and with them most fork handoffs, stay within one node.
+ */
+
+#define _GNU_SOURCE
+#include "philo.h"
+#include <sched.h>
+#include <sys/syscall.h>
+#include <linux/mempolicy.h>
+
+/**
+ * @brief Returns the first philosopher placed on topology group `k`.
+ *
+ * @param env Pointer to the environment structure.
+ * @param k Group index, up to `num_nodes` for the end of the last group.
+ * @return int Index of the first philosopher of the group.
+ */
+static int	group_start(t_env *env, int k)
+{
+	return ((int)(((long)env->topo.node_first[k] * env->cfg.num_philo
+			+ env->topo.num_cpus - 1) / env->topo.num_cpus));
+}
+
+/**
+ * @brief Asks the kernel to back elements `r[0]` to `r[1]` of `base` with
+ * memory of NUMA node `node`.
+ *
+ * Only whole pages inside the range are bound, so a page shared with the
+ * neighbouring slice stays where it is. Binding is best effort and any
+ * error is ignored.
+ *
+ * @param base Start of the array.
+ * @param size Size of one element.
+ * @param r First and end element of the slice.
+ * @param node NUMA node number.
+ */
+static void	bind_range(void *base, size_t size, const int *r, int node)
+{
+	unsigned long	mask;
+	uintptr_t		start;
+	uintptr_t		end;
+	uintptr_t		page;
+
+	if (node >= (int)(sizeof(mask) * 8 - 1))
+		return ;
+	page = sysconf(_SC_PAGESIZE);
+	start = ((uintptr_t)base + r[0] * size + page - 1) & ~(page - 1);
+	end = ((uintptr_t)base + r[1] * size) & ~(page - 1);
+	if (end <= start)
+		return ;
+	mask = 1UL << node;
+	(void)syscall(SYS_mbind, start, end - start, MPOL_PREFERRED, &mask,
+		sizeof(mask) * 8, MPOL_MF_MOVE);
+}
+
+/**
+ * @brief Binds each node's slice of the philosopher data to that node.
+ *
+ * This covers `philos`, the hot `last_meal`, `deadline` and `meals`
+ * arrays and the forks: `forks` with mutex forks, or the words of
+ * `fork_table` holding the group's bits and their `waiters` counters.
+ *
+ * @param env Pointer to the environment structure.
+ */
+static void	bind_nodes(t_env *env)
+{
+	int	k;
+	int	r[2];
+	int	w[2];
+	int	node;
+
+	k = 0;
+	while (k < env->topo.num_nodes)
+	{
+		r[0] = group_start(env, k);
+		r[1] = group_start(env, k + 1);
+		w[0] = r[0] / FORK_WORD_BITS;
+		w[1] = r[1] / FORK_WORD_BITS;
+		node = env->topo.node_ids[k];
+		bind_range(env->philos, sizeof(t_philo), r, node);
+		bind_range(env->last_meal, sizeof(long), r, node);
+		bind_range(env->deadline, sizeof(long), r, node);
+		bind_range(env->meals, sizeof(int), r, node);
+		if (env->forks)
+			bind_range(env->forks, sizeof(pthread_mutex_t), r, node);
+		if (env->fork_table.words)
+			bind_range(env->fork_table.words, sizeof(uint64_t), w, node);
+		if (env->fork_table.waiters)
+			bind_range(env->fork_table.waiters, sizeof(atomic_int), w, node);
+		k++;
+	}
+}
+
+/**
+ * @brief Loads the topology and places the philosopher data.
+ *
+ * Called right after the philosopher and fork arrays are carved and before
+ * they are first written, so that their pages are faulted in on the bound
+ * node. With `--report`, also allocates the per-fork record of the node
+ * that last held each fork.
+ *
+ * @param env Pointer to the environment structure.
+ * @return int Returns EXIT_SUCCESS if memory allocation is successful,
+ * otherwise returns EXIT_FAILURE.
+ */
+int	alloc_placement(t_env *env)
+{
+	int	i;
+
+	if (env->opts.placement == PLACE_NONE && !env->opts.report)
+		return (EXIT_SUCCESS);
+	if (load_topology(&env->topo) == EXIT_SUCCESS
+		&& env->opts.placement == PLACE_NUMA && env->topo.num_nodes > 1)
+		bind_nodes(env);
+	if (!env->opts.report)
+		return (EXIT_SUCCESS);
+	env->fork_node = malloc(env->cfg.num_philo * sizeof(int));
+	if (!env->fork_node)
+		return (EXIT_FAILURE);
+	i = 0;
+	while (i < env->cfg.num_philo)
+	{
+		env->fork_node[i] = -1;
+		i++;
+	}
+	return (EXIT_SUCCESS);
+}
+
+/**
+ * @brief Pins a thread to the CPU of philosopher `i`.
+ *
+ * Philosopher threads are pinned by their own index; pool workers,
+ * coroutine carriers and monitor shards by the first philosopher they
+ * serve. Does nothing unless `--placement=numa` is given. Pinning is best
+ * effort: a failure only costs locality, so it is ignored.
+ *
+ * @param env Pointer to the environment structure.
+ * @param thread The thread to pin.
+ * @param i Index of the philosopher that decides the CPU.
+ */
+void	place_thread(t_env *env, pthread_t thread, int i)
+{
+	cpu_set_t	set;
+
+	if (env->opts.placement != PLACE_NUMA || env->topo.num_cpus == 0)
+		return ;
+	CPU_ZERO(&set);
+	CPU_SET(env->topo.cpus[(long)i * env->topo.num_cpus / env->cfg.num_philo],
+		&set);
+	(void)pthread_setaffinity_np(thread, sizeof(set), &set);
+}
@@ -0,0 +1,95 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   placement_stats.c                                  :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: imunaev- <imunaev-@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/03/23 16:10:54 by imunaev-          #+#    #+#             */
+/*   Updated: 2025/03/23 16:10:54 by imunaev-         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file placement_stats.c
+ * @brief Fork handoff and throughput statistics for `--report`.
+ *
+ * Every time a philosopher takes its forks, the NUMA node it runs on is
+ * compared with the node of the previous holder of each fork. A mismatch
+ * means the fork's cache lines crossed the interconnect. Running the same
+ * simulation with and without `--placement=numa` shows what pinning saves.
+ */
+
+#define _GNU_SOURCE
+#include "philo.h"
+#include <sched.h>
+
+/**
+ * @brief Records the node of the calling philosopher on both of its forks.
+ *
+ * Called while the philosopher holds both forks, which makes it the only
+ * writer of their `fork_node` entries. Does nothing without `--report`.
+ *
+ * @param p Pointer to the philosopher structure.
+ */
+void	note_handoff(t_philo *p)
+{
+	t_env	*env;
+	int		node;
+	int		f;
+	int		i;
+
+	env = p->env;
+	if (!env->fork_node)
+		return ;
+	node = sched_getcpu();
+	if (node >= 0 && node < MAX_CPUS)
+		node = env->topo.cpu_node[node];
+	i = 0;
+	while (i < 2)
+	{
+		f = (p->id + i) % p->env->cfg.num_philo;
+		if (env->fork_node[f] >= 0)
+		{
+			atomic_fetch_add(&env->handoffs, 1);
+			if (env->fork_node[f] != node)
+				atomic_fetch_add(&env->cross_handoffs, 1);
+		}
+		env->fork_node[f] = node;
+		i++;
+	}
+}
+
+/**
+ * @brief Reports the placement, the meal throughput and the fork handoffs
+ * that crossed NUMA nodes.
+ *
+ * @param env Pointer to the environment structure.
+ */
+void	report_placement(t_env *env)
+{
+	static const char *const	names[] = {"none", "numa"};
+	long						meals;
+	long						ms;
+	int							i;
+
+	if (!env->fork_node)
+		return ;
+	meals = 0;
+	i = 0;
+	while (i < env->cfg.num_philo)
+	{
+		meals += env->meals[i];
+		i++;
+	}
+	ms = get_time() - env->start_time;
+	if (ms < 1)
+		ms = 1;
+	fprintf(stderr, "placement: %s, %d NUMA nodes, %d cpus\n",
+		names[env->opts.placement],
+		env->topo.num_nodes, env->topo.num_cpus);
+	fprintf(stderr, "throughput: %ld meals in %ld ms (%ld meals/s)\n",
+		meals, ms, meals * 1000 / ms);
+	fprintf(stderr, "fork handoffs: %ld, cross-node %ld\n",
+		atomic_load(&env->handoffs), atomic_load(&env->cross_handoffs));
+}
@@ -0,0 +1,171 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   pool.c                                             :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: imunaev- <imunaev-@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/03/20 15:40:19 by imunaev-          #+#    #+#             */
+/*   Updated: 2025/03/21 12:20:36 by imunaev-         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file pool.c
+ * @brief Work-stealing loop of the worker pool engine.
+ *
+ * Each worker steps philosophers from its own run deque. A philosopher
+ * that has to wait (eating, sleeping, thinking) sets a timer on its home
+ * worker instead of sleeping, and the home worker moves it back to its
+ * deque when the timer is due. A worker with nothing to run steals from
+ * the others before it goes idle.
+ */
+
+#include "philo.h"
+#include <limits.h>
+
+/**
+ * @brief Moves every home philosopher whose timer is due to the deque.
+ *
+ * @param w Pointer to the worker.
+ */
+static void	release_due(t_pool_worker *w)
+{
+	t_deadline_heap	*h;
+	long			now;
+	int				id;
+
+	h = &w->timers;
+	now = get_time();
+	pthread_mutex_lock(&h->mutex);
+	while (h->deadline[h->heap[0]] <= now)
+	{
+		id = h->heap[0];
+		heap_set_key(h, id, LONG_MAX);
+		deque_push(&w->deque, id + h->base);
+	}
+	pthread_mutex_unlock(&h->mutex);
+	if (deque_size(&w->deque) > 1)
+		pool_wake_idle(w->env->pool, w);
+}
+
+/**
+ * @brief Steals a philosopher from the first other worker that has one.
+ *
+ * Victims are tried in order starting after `w`, so that idle workers
+ * spread over different victims.
+ *
+ * @param w Pointer to the stealing worker.
+ * @return int Index of the stolen philosopher, or DEQUE_EMPTY.
+ */
+static int	steal_work(t_pool_worker *w)
+{
+	t_pool	*pool;
+	int		i;
+	int		id;
+
+	pool = w->env->pool;
+	i = 1;
+	while (i < pool->num_workers)
+	{
+		id = deque_steal(&pool->workers[(w->index + i)
+				% pool->num_workers].deque);
+		if (id >= 0)
+		{
+			w->steals++;
+			return (id);
+		}
+		if (id == DEQUE_EMPTY)
+			i++;
+	}
+	return (DEQUE_EMPTY);
+}
+
+/**
+ * @brief Steals work, or sleeps until the worker's earliest timer.
+ *
+ * The sleep is not bounded: an earlier timer, work to steal and the end
+ * of the simulation all signal the worker's condition variable.
+ *
+ * Thread safety:
+ * - `idle` is raised under the worker's mutex before the last steal
+ *   attempt; see `pool_wake_idle()`.
+ * - `ended` is read under the same mutex before the wait, and
+ *   `wake_monitors()` takes it to broadcast, so the end cannot be missed.
+ *
+ * @param w Pointer to the worker.
+ * @return int Index of a stolen philosopher, or DEQUE_EMPTY.
+ */
+static int	wait_for_work(t_pool_worker *w)
+{
+	t_deadline_heap	*h;
+	int				id;
+
+	h = &w->timers;
+	pthread_mutex_lock(&h->mutex);
+	atomic_store(&w->idle, true);
+	id = steal_work(w);
+	if (id == DEQUE_EMPTY && !should_terminate(w->env))
+		heap_wait_until(h, h->deadline[h->heap[0]]);
+	atomic_store(&w->idle, false);
+	pthread_mutex_unlock(&h->mutex);
+	return (id);
+}
+
+/**
+ * @brief Returns the next philosopher for worker `w` to step.
+ *
+ * Due timers are released before every step so that a busy deque cannot
+ * hold them back.
+ *
+ * @param w Pointer to the worker.
+ * @return int Index of the philosopher to step, or -1 once the simulation
+ * has ended.
+ */
+static int	pool_next(t_pool_worker *w)
+{
+	int	id;
+
+	while (!should_terminate(w->env))
+	{
+		release_due(w);
+		id = deque_take(&w->deque);
+		if (id == DEQUE_EMPTY)
+			id = wait_for_work(w);
+		if (id >= 0)
+			return (id);
+	}
+	return (-1);
+}
+
+/**
+ * @brief Worker thread function of the pool engine.
+ *
+ * Waits on the start gate like a philosopher thread would, then steps
+ * philosophers until the simulation ends, accounting the time spent in
+ * steps as busy time.
+ *
+ * @param arg Pointer to the worker (`t_pool_worker`).
+ * @return NULL when the worker exits.
+ */
+void	*pool_worker(void *arg)
+{
+	t_pool_worker	*w;
+	long			t0;
+	int				id;
+
+	w = (t_pool_worker *)arg;
+	announce_ready(w->env);
+	(void)await_start(w->env);
+	id = pool_next(w);
+	while (id >= 0)
+	{
+		t0 = get_time_us();
+		w->env->philos[id].worker = w->index;
+		philo_step(&w->env->philos[id]);
+		w->busy_us += get_time_us() - t0;
+		w->steps++;
+		id = pool_next(w);
+	}
+	return (NULL);
+}
@@ -0,0 +1,151 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   pool_alloc.c                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: imunaev- <imunaev-@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/03/21 11:03:17 by imunaev-          #+#    #+#             */
+/*   Updated: 2025/03/21 11:03:17 by imunaev-         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file pool_alloc.c
+ * @brief Allocation and release of the worker pool engine.
+ */
+
+#include "philo.h"
+
+/**
+ * @brief Returns the requested number of workers.
+ *
+ * The pool size defaults to one worker per online core and never exceeds
+ * the number of philosophers. The coroutine engine uses the same count for
+ * its carrier threads.
+ *
+ * @param env Pointer to the environment structure.
+ * @return int Number of workers to split the philosophers between.
+ */
+int	pool_size(t_env *env)
+{
+	int	n;
+
+	n = env->opts.workers;
+	if (n < 1)
+		n = sysconf(_SC_NPROCESSORS_ONLN);
+	if (n < 1)
+		n = 1;
+	if (n > env->cfg.num_philo)
+		n = env->cfg.num_philo;
+	return (n);
+}
+
+/**
+ * @brief Sets up worker `i` with its home range, run deque and timers.
+ *
+ * Each deque can hold every philosopher, because a woken philosopher is
+ * queued on the worker that woke it rather than on its home worker.
+ *
+ * @param env Pointer to the environment structure.
+ * @param i Index of the worker.
+ * @return int Returns EXIT_SUCCESS if memory allocation is successful,
+ * otherwise returns EXIT_FAILURE.
+ */
+static int	alloc_worker(t_env *env, int i)
+{
+	t_pool_worker	*w;
+
+	w = &env->pool->workers[i];
+	w->env = env;
+	w->index = i;
+	w->lo = i * env->pool->block;
+	w->hi = w->lo + env->pool->block;
+	if (w->hi > env->cfg.num_philo)
+		w->hi = env->cfg.num_philo;
+	atomic_init(&w->idle, false);
+	if (alloc_deque(&w->deque, env->cfg.num_philo) == EXIT_FAILURE)
+		return (EXIT_FAILURE);
+	return (alloc_heap(&w->timers, w->lo, w->hi - w->lo));
+}
+
+/**
+ * @brief Allocates the worker pool when `--engine=pool` is selected.
+ *
+ * The philosophers are split into contiguous blocks, one per worker, so
+ * that neighbours sharing a fork have their timers on the same worker. The
+ * start gate then waits for the workers instead of the philosophers.
+ *
+ * @param env Pointer to the environment structure.
+ * @return int Returns EXIT_SUCCESS if memory allocation is successful,
+ * otherwise returns EXIT_FAILURE.
+ */
+int	alloc_pool(t_env *env)
+{
+	t_pool	*pool;
+	int		i;
+
+	if (env->opts.engine != ENGINE_POOL)
+		return (EXIT_SUCCESS);
+	pool = calloc(1, sizeof(t_pool));
+	if (!pool || pthread_mutex_init(&pool->park_mutex, NULL) != 0)
+	{
+		free(pool);
+		return (EXIT_FAILURE);
+	}
+	env->pool = pool;
+	pool->block = (env->cfg.num_philo + pool_size(env) - 1) / pool_size(env);
+	pool->num_workers = (env->cfg.num_philo + pool->block - 1) / pool->block;
+	env->start_expected = pool->num_workers;
+	pool->workers = calloc(pool->num_workers, sizeof(t_pool_worker));
+	i = 0;
+	while (pool->workers && i < pool->num_workers
+		&& alloc_worker(env, i) == EXIT_SUCCESS)
+		i++;
+	if (i < pool->num_workers)
+		return (EXIT_FAILURE);
+	return (EXIT_SUCCESS);
+}
+
+/**
+ * @brief Releases the deque and timers of one worker.
+ *
+ * @param w Pointer to the worker.
+ */
+static void	free_worker(t_pool_worker *w)
+{
+	if (w->timers.heap)
+	{
+		(void)pthread_mutex_destroy(&w->timers.mutex);
+		(void)pthread_cond_destroy(&w->timers.cond);
+	}
+	free(w->timers.heap);
+	free(w->timers.pos);
+	free(w->timers.deadline);
+	free(w->deque.buf);
+}
+
+/**
+ * @brief Releases the worker pool.
+ *
+ * @param env Pointer to the environment structure.
+ */
+void	free_pool(t_env *env)
+{
+	t_pool	*pool;
+	int		i;
+
+	pool = env->pool;
+	if (!pool)
+		return ;
+	i = 0;
+	while (pool->workers && i < pool->num_workers)
+	{
+		free_worker(&pool->workers[i]);
+		i++;
+	}
+	free(pool->workers);
+	(void)pthread_mutex_destroy(&pool->park_mutex);
+	free(pool);
+	env->pool = NULL;
+}
@@ -0,0 +1,93 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   pool_forks.c                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: imunaev- <imunaev-@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/03/20 16:11:52 by imunaev-          #+#    #+#             */
+/*   Updated: 2025/03/21 12:55:03 by imunaev-         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file pool_forks.c
+ * @brief Fork waiting for philosophers run by the worker pool.
+ *
+ * A hungry philosopher that cannot take its forks is parked instead of
+ * blocking its worker. The neighbour that later releases a shared fork
+ * puts it on its own worker's run deque, which keeps neighbours together.
+ */
+
+#include "philo.h"
+
+/**
+ * @brief Tries to take both forks, parking the philosopher on failure.
+ *
+ * The second attempt and the parking happen under `park_mutex`, and a
+ * releasing neighbour takes the same mutex after freeing its forks, so a
+ * release can never slip between the attempt and the parking. A pair of
+ * forks straddling a bitmap word is only tried in the second attempt, so
+ * its transient first bit is given back before any neighbour can park on
+ * it. Under
+ * `--replay` a philosopher whose recorded turn has not come is parked
+ * too: the neighbour that is served before it wakes it after its meal.
+ *
+ * @param p Pointer to the philosopher structure.
+ * @return true if the philosopher holds both forks, false if it is parked.
+ */
+bool	pool_try_eat(t_philo *p)
+{
+	t_pool	*pool;
+	bool	taken;
+
+	if (replay_turn(p) && bitmap_try_take_forks(p, false))
+		return (true);
+	pool = p->env->pool;
+	pthread_mutex_lock(&pool->park_mutex);
+	taken = replay_turn(p) && bitmap_try_take_forks(p, true);
+	if (!taken)
+		p->waiting = true;
+	pthread_mutex_unlock(&pool->park_mutex);
+	return (taken);
+}
+
+/**
+ * @brief Requeues a parked philosopher on the deque of worker `w`.
+ *
+ * The caller holds `park_mutex` and runs on `w`.
+ *
+ * @param env Pointer to the environment structure.
+ * @param w Pointer to the current worker.
+ * @param id Index of the philosopher.
+ */
+static void	wake_one(t_env *env, t_pool_worker *w, int id)
+{
+	if (!env->philos[id].waiting)
+		return ;
+	env->philos[id].waiting = false;
+	deque_push(&w->deque, id);
+}
+
+/**
+ * @brief Requeues the neighbours that share a fork with philosopher `id`.
+ *
+ * Called after the philosopher released its forks. The neighbours go to
+ * the worker running this step; if it now has more than one philosopher
+ * queued, an idle worker is woken to steal one.
+ *
+ * @param env Pointer to the environment structure.
+ * @param id Index of the philosopher that released its forks.
+ */
+void	pool_wake_neighbours(t_env *env, int id)
+{
+	t_pool_worker	*w;
+
+	w = &env->pool->workers[env->philos[id].worker];
+	pthread_mutex_lock(&env->pool->park_mutex);
+	wake_one(env, w, (id + env->cfg.num_philo - 1) % env->cfg.num_philo);
+	wake_one(env, w, (id + 1) % env->cfg.num_philo);
+	pthread_mutex_unlock(&env->pool->park_mutex);
+	if (deque_size(&w->deque) > 1)
+		pool_wake_idle(env->pool, w);
+}
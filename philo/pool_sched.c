@@ -0,0 +1,103 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   pool_sched.c                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: imunaev- <imunaev-@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/03/21 11:41:02 by imunaev-          #+#    #+#             */
+/*   Updated: 2025/03/21 11:41:02 by imunaev-         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file pool_sched.c
+ * @brief Timers and idle wake-ups of the worker pool engine.
+ */
+
+#include "philo.h"
+
+/**
+ * @brief Wakes one idle worker so that it can steal from `self`.
+ *
+ * Called after `self` queued work it will not get to right away. The caller
+ * must not hold any worker mutex.
+ *
+ * Thread safety:
+ * - An idle worker raises its flag under its own mutex before its last
+ *   steal attempt, and the signal is sent under the same mutex, so a push
+ *   is either seen by that attempt or wakes the worker.
+ *
+ * @param pool Pointer to the worker pool.
+ * @param self Worker that queued the work.
+ */
+void	pool_wake_idle(t_pool *pool, t_pool_worker *self)
+{
+	t_pool_worker	*w;
+	int				i;
+
+	atomic_thread_fence(memory_order_seq_cst);
+	i = 0;
+	while (i < pool->num_workers)
+	{
+		w = &pool->workers[i];
+		if (w != self && atomic_load(&w->idle))
+		{
+			pthread_mutex_lock(&w->timers.mutex);
+			pthread_cond_signal(&w->timers.cond);
+			pthread_mutex_unlock(&w->timers.mutex);
+			return ;
+		}
+		i++;
+	}
+}
+
+/**
+ * @brief Wakes every worker so it notices the end of the simulation.
+ *
+ * Called from `wake_monitors()` by whoever sets `ended`.
+ *
+ * @param env Pointer to the environment structure.
+ */
+void	pool_wake_all(t_env *env)
+{
+	t_deadline_heap	*h;
+	int				i;
+
+	if (!env->pool)
+		return ;
+	i = 0;
+	while (i < env->pool->num_workers)
+	{
+		h = &env->pool->workers[i].timers;
+		pthread_mutex_lock(&h->mutex);
+		pthread_cond_broadcast(&h->cond);
+		pthread_mutex_unlock(&h->mutex);
+		i++;
+	}
+}
+
+/**
+ * @brief Sets the time at which a philosopher's next step is due.
+ *
+ * The timer goes to the philosopher's home worker, whichever worker runs
+ * the current step, so that the philosopher returns there when it is due.
+ *
+ * Thread safety:
+ * - Uses the home worker's mutex and wakes it in case the new timer is its
+ *   earliest.
+ *
+ * @param env Pointer to the environment structure.
+ * @param id Index of the philosopher.
+ * @param at Absolute time of the next step in milliseconds.
+ */
+void	pool_schedule(t_env *env, int id, long at)
+{
+	t_deadline_heap	*h;
+
+	h = &env->pool->workers[id / env->pool->block].timers;
+	pthread_mutex_lock(&h->mutex);
+	heap_set_key(h, id - h->base, at);
+	pthread_cond_signal(&h->cond);
+	pthread_mutex_unlock(&h->mutex);
+}
@@ -0,0 +1,111 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   pool_setup.c                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: imunaev- <imunaev-@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/03/20 17:20:05 by imunaev-          #+#    #+#             */
+/*   Updated: 2025/03/21 12:41:50 by imunaev-         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file pool_setup.c
+ * @brief Start and teardown of the worker pool threads.
+ */
+
+#include "philo.h"
+#include <limits.h>
+
+/**
+ * @brief Queues every philosopher on its home worker for its first step.
+ *
+ * Called from `release_start_gate()` while the workers are still parked.
+ *
+ * @param env Pointer to the environment structure.
+ */
+void	pool_seed(t_env *env)
+{
+	t_pool_worker	*w;
+	int				i;
+
+	i = 0;
+	while (i < env->pool->num_workers)
+	{
+		w = &env->pool->workers[i];
+		heap_fill(&w->timers, LONG_MAX);
+		atomic_store(&w->deque.top, 0);
+		atomic_store(&w->deque.bottom, 0);
+		w->steps = 0;
+		w->steals = 0;
+		w->busy_us = 0;
+		i++;
+	}
+	i = 0;
+	while (i < env->cfg.num_philo)
+	{
+		env->philos[i].phase = PHASE_ARRIVING;
+		env->philos[i].waiting = false;
+		env->philos[i].worker = i / env->pool->block;
+		deque_push(&env->pool->workers[i / env->pool->block].deque, i);
+		i++;
+	}
+}
+
+/**
+ * @brief Creates the worker threads of the pool.
+ *
+ * If a thread fails to create, it sets `env->ended` to true and opens the
+ * start gate so that the workers already created can exit.
+ *
+ * Thread safety:
+ * - Uses `end_mutex` to safely update the `ended` flag upon failure.
+ *
+ * @param env Pointer to the environment structure.
+ * @return int Returns EXIT_SUCCESS if all threads are created successfully,
+ * otherwise EXIT_FAILURE.
+ */
+int	create_pool_workers(t_env *env)
+{
+	t_pool	*pool;
+
+	pool = env->pool;
+	while (pool->created < pool->num_workers)
+	{
+		if (start_thread(env, &pool->workers[pool->created].thread,
+				pool_worker, &pool->workers[pool->created]) != 0)
+		{
+			print_error("Error: Failed to create pool worker thread\n");
+			stat_lock(env, &env->end_mutex, LOCK_END);
+			env->ended = true;
+			pthread_mutex_unlock(&env->end_mutex);
+			wake_monitors(env);
+			release_start_gate(env, get_time());
+			return (EXIT_FAILURE);
+		}
+		place_thread(env, pool->workers[pool->created].thread,
+			pool->workers[pool->created].lo);
+		pool->created++;
+	}
+	return (EXIT_SUCCESS);
+}
+
+/**
+ * @brief Joins every worker thread that was created.
+ *
+ * @param env Pointer to the environment structure.
+ */
+void	join_pool_workers(t_env *env)
+{
+	int	i;
+
+	if (!env->pool)
+		return ;
+	i = 0;
+	while (i < env->pool->created)
+	{
+		pthread_join(env->pool->workers[i].thread, NULL);
+		i++;
+	}
+}
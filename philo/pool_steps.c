@@ -0,0 +1,135 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   pool_steps.c                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: imunaev- <imunaev-@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/03/20 16:48:30 by imunaev-          #+#    #+#             */
+/*   Updated: 2025/03/20 16:48:30 by imunaev-         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file pool_steps.c
+ * @brief Philosopher state machine for the worker pool engine.
+ *
+ * Each call to `philo_step()` performs one transition of
+ * thinking → hungry → eating → sleeping → thinking and sets the timer for
+ * the next one. Output, death and meal semantics match the thread engine.
+ */
+
+#include "philo.h"
+
+/**
+ * @brief Starts a meal once both forks are held.
+ *
+ * @param p Pointer to the philosopher structure.
+ */
+static void	start_eating(t_philo *p)
+{
+	t_env	*env;
+
+	env = p->env;
+	DTRACE_PROBE1(philo, fork_acquire_end, p->id + 1);
+	latency_meal(p);
+	grant_record(p);
+	note_handoff(p);
+	print_status(p, "has taken a fork");
+	print_status(p, "has taken a fork");
+	start_meal(p);
+	print_status(p, "is eating");
+	p->phase = PHASE_EATING;
+	pool_schedule(env, p->id, env->last_meal[p->id] + p->eat_time);
+}
+
+/**
+ * @brief Makes the philosopher hungry and tries to start eating.
+ *
+ * This is where the thread engine checks its loop condition, so a
+ * philosopher stops here once the simulation ended or it ate enough. A
+ * lone philosopher takes its only fork and waits to die.
+ *
+ * @param p Pointer to the philosopher structure.
+ */
+static void	become_hungry(t_philo *p)
+{
+	if (should_terminate(p->env) || (p->meals_limit != -1
+			&& p->env->meals[p->id] >= p->meals_limit))
+	{
+		p->phase = PHASE_DONE;
+		return ;
+	}
+	if (p->env->cfg.num_philo == 1)
+	{
+		print_status(p, "has taken a fork");
+		p->phase = PHASE_DONE;
+		return ;
+	}
+	if (p->phase != PHASE_HUNGRY)
+	{
+		DTRACE_PROBE1(philo, fork_acquire_begin, p->id + 1);
+		latency_hungry(p);
+	}
+	p->phase = PHASE_HUNGRY;
+	if (pool_try_eat(p))
+		start_eating(p);
+}
+
+/**
+ * @brief Ends a meal: counts it, releases the forks and goes to sleep.
+ *
+ * @param p Pointer to the philosopher structure.
+ */
+static void	finish_eating(t_philo *p)
+{
+	count_meal(p);
+	bitmap_put_forks(p);
+	pool_wake_neighbours(p->env, p->id);
+	print_status(p, "is sleeping");
+	DTRACE_PROBE2(philo, sleep_begin, p->id + 1, p->sleep_time);
+	p->phase = PHASE_SLEEPING;
+	pool_schedule(p->env, p->id, get_time() + p->sleep_time);
+}
+
+/**
+ * @brief Ends the sleep and thinks for as long as the thread engine does.
+ *
+ * @param p Pointer to the philosopher structure.
+ */
+static void	finish_sleeping(t_philo *p)
+{
+	DTRACE_PROBE2(philo, sleep_end, p->id + 1, p->sleep_time);
+	print_status(p, "is thinking");
+	p->phase = PHASE_THINKING;
+	if (p->env->cfg.num_philo & 1)
+		pool_schedule(p->env, p->id, get_time() + p->sleep_time);
+	else
+		pool_schedule(p->env, p->id, get_time() + 1);
+}
+
+/**
+ * @brief Advances a philosopher's state machine by one step.
+ *
+ * On arrival, philosophers are staggered exactly like `self_arrange()`:
+ * odd-indexed ones, and the first one when the count is odd, think first.
+ *
+ * @param p Pointer to the philosopher structure.
+ */
+void	philo_step(t_philo *p)
+{
+	if (p->phase == PHASE_EATING)
+		finish_eating(p);
+	else if (p->phase == PHASE_SLEEPING)
+		finish_sleeping(p);
+	else if (p->phase == PHASE_ARRIVING && p->env->cfg.num_philo > 1
+		&& ((p->id & 1) || ((p->env->cfg.num_philo & 1) && p->id == 0)))
+	{
+		print_status(p, "is thinking");
+		p->phase = PHASE_THINKING;
+		pool_schedule(p->env, p->id,
+			get_time() + (p->eat_time << (p->id == 0)));
+	}
+	else if (p->phase != PHASE_DONE)
+		become_hungry(p);
+}
@@ -0,0 +1,157 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   report.c                                           :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: imunaev- <imunaev-@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/03/19 13:40:11 by imunaev-          #+#    #+#             */
+/*   Updated: 2025/03/19 13:40:11 by imunaev-         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file report.c
+ * @brief Run report printed at exit when `--report` is given.
+ *
+ * The report goes to standard error so that the simulation log on standard
+ * output keeps its usual format.
+ */
+
+#include "philo.h"
+#include <limits.h>
+
+/**
+ * @brief Reports the thread creation time, when the start gate opened and
+ * how closely philosophers resumed at the start instant.
+ *
+ * @param env Pointer to the environment structure.
+ */
+static void	report_start_skew(t_env *env)
+{
+	long	lo;
+	long	hi;
+	int		i;
+
+	if (env->num_spawners > 0)
+		fprintf(stderr, "startup: %d philosopher threads created in %ld us "
+			"by %d spawners\n", env->cfg.num_philo, env->spawn_us,
+			env->num_spawners);
+	fprintf(stderr, "start gate opened %ld ms after launch\n",
+		env->start_time - env->launch_time);
+	lo = LONG_MAX;
+	hi = 0;
+	i = 0;
+	while (i < env->cfg.num_philo)
+	{
+		if (env->philos[i].start_lag < lo)
+			lo = env->philos[i].start_lag;
+		if (env->philos[i].start_lag > hi)
+			hi = env->philos[i].start_lag;
+		i++;
+	}
+	fprintf(stderr, "start skew: min %ld us, max %ld us, spread %ld us\n",
+		lo, hi, hi - lo);
+}
+
+/**
+ * @brief Reports the scan time of each monitor shard and the death
+ * detection latency.
+ *
+ * @param env Pointer to the environment structure.
+ */
+static void	report_monitor(t_env *env)
+{
+	t_monitor_shard	*s;
+	int				i;
+
+	if (env->opts.monitor_mode == MONITOR_POLL)
+		fprintf(stderr, "monitor scan kernel: %s\n", env->scan.name);
+	i = 0;
+	while (i < env->num_shards)
+	{
+		s = &env->shards[i];
+		fprintf(stderr, "monitor shard %d [%d-%d]: %ld scans, avg %ld us, "
+			"max %ld us\n", i, s->lo + 1, s->hi, s->scans,
+			s->scan_total_us / (s->scans + !s->scans), s->scan_max_us);
+		i++;
+	}
+	if (env->death_latency >= 0)
+		fprintf(stderr, "death detected %ld us after deadline\n",
+			env->death_latency);
+}
+
+/**
+ * @brief Reports how the philosophers' steps spread over the pool workers.
+ *
+ * Utilization is the share of the run a worker spent stepping
+ * philosophers; steals count the steps it took from other workers' deques.
+ *
+ * @param env Pointer to the environment structure.
+ */
+static void	report_pool(t_env *env)
+{
+	t_pool_worker	*w;
+	long			run_us;
+	long			permille;
+	int				i;
+
+	run_us = (get_time() - env->start_time) * 1000;
+	if (run_us < 1)
+		run_us = 1;
+	i = 0;
+	while (i < env->pool->num_workers)
+	{
+		w = &env->pool->workers[i];
+		permille = w->busy_us * 1000 / run_us;
+		fprintf(stderr, "pool worker %d [%d-%d]: %ld steps, %ld steals, "
+			"busy %ld us (%ld.%ld%%)\n", i, w->lo + 1, w->hi, w->steps,
+			w->steals, w->busy_us, permille / 10, permille % 10);
+		i++;
+	}
+}
+
+/**
+ * @brief Reports the context switches of each coroutine carrier.
+ *
+ * @param env Pointer to the environment structure.
+ */
+static void	report_coro(t_env *env)
+{
+	t_carrier	*c;
+	int			i;
+
+	fprintf(stderr, "coroutine stacks: %d x %d KB\n", env->cfg.num_philo,
+		CORO_STACK_SIZE / 1024);
+	i = 0;
+	while (i < env->coro->num_carriers)
+	{
+		c = &env->coro->carriers[i];
+		fprintf(stderr, "coro carrier %d [%d-%d]: %ld switches\n", i,
+			c->lo + 1, c->hi, c->switches);
+		i++;
+	}
+}
+
+/**
+ * @brief Prints the lock profile and the run report if they were
+ * requested.
+ *
+ * @param env Pointer to the environment structure.
+ */
+void	print_report(t_env *env)
+{
+	if (env->opts.lockstat)
+		report_locks(env);
+	if (!env->opts.report)
+		return ;
+	report_start_skew(env);
+	report_first_meal(env);
+	if (env->pool)
+		report_pool(env);
+	if (env->coro)
+		report_coro(env);
+	report_monitor(env);
+	report_placement(env);
+	report_latency(env);
+}
@@ -0,0 +1,143 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   run_deque.c                                        :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: imunaev- <imunaev-@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/03/21 10:12:44 by imunaev-          #+#    #+#             */
+/*   Updated: 2025/03/21 10:12:44 by imunaev-         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file run_deque.c
+ * @brief Chase-Lev work-stealing deque used by the pool workers.
+ *
+ * The owner pushes and takes at the bottom, so the philosopher it queued
+ * last (usually a neighbour it just woke) runs next on the same worker.
+ * Idle workers steal the oldest entry from the top with a compare-and-swap.
+ */
+
+#include "philo.h"
+
+/**
+ * @brief Allocates an empty deque with room for `size` philosophers.
+ *
+ * @param q Pointer to the deque.
+ * @param size Maximum number of queued philosophers.
+ * @return int Returns EXIT_SUCCESS if memory allocation is successful,
+ * otherwise returns EXIT_FAILURE.
+ */
+int	alloc_deque(t_run_deque *q, int size)
+{
+	long	cap;
+
+	cap = 1;
+	while (cap < size)
+		cap <<= 1;
+	q->buf = calloc(cap, sizeof(atomic_int));
+	if (!q->buf)
+		return (EXIT_FAILURE);
+	q->mask = cap - 1;
+	atomic_init(&q->top, 0);
+	atomic_init(&q->bottom, 0);
+	return (EXIT_SUCCESS);
+}
+
+/**
+ * @brief Pushes a philosopher at the bottom of the deque.
+ *
+ * Only the owning worker calls this, or the main thread before the start
+ * gate opens.
+ *
+ * @param q Pointer to the deque.
+ * @param id Index of the philosopher.
+ */
+void	deque_push(t_run_deque *q, int id)
+{
+	long	b;
+
+	b = atomic_load_explicit(&q->bottom, memory_order_relaxed);
+	atomic_store_explicit(&q->buf[b & q->mask], id, memory_order_relaxed);
+	atomic_thread_fence(memory_order_release);
+	atomic_store_explicit(&q->bottom, b + 1, memory_order_relaxed);
+}
+
+/**
+ * @brief Takes the philosopher at the bottom of the deque.
+ *
+ * Only the owning worker calls this. When a single entry is left, the
+ * owner races thieves for it on `top`.
+ *
+ * @param q Pointer to the deque.
+ * @return int Index of the philosopher, or DEQUE_EMPTY.
+ */
+int	deque_take(t_run_deque *q)
+{
+	long	b;
+	long	t;
+	int		id;
+
+	b = atomic_load_explicit(&q->bottom, memory_order_relaxed) - 1;
+	atomic_store_explicit(&q->bottom, b, memory_order_relaxed);
+	atomic_thread_fence(memory_order_seq_cst);
+	t = atomic_load_explicit(&q->top, memory_order_relaxed);
+	if (t > b)
+	{
+		atomic_store_explicit(&q->bottom, b + 1, memory_order_relaxed);
+		return (DEQUE_EMPTY);
+	}
+	id = atomic_load_explicit(&q->buf[b & q->mask], memory_order_relaxed);
+	if (t == b)
+	{
+		if (!atomic_compare_exchange_strong_explicit(&q->top, &t, t + 1,
+				memory_order_seq_cst, memory_order_relaxed))
+			id = DEQUE_EMPTY;
+		atomic_store_explicit(&q->bottom, b + 1, memory_order_relaxed);
+	}
+	return (id);
+}
+
+/**
+ * @brief Steals the philosopher at the top of another worker's deque.
+ *
+ * @param q Pointer to the victim's deque.
+ * @return int Index of the philosopher, DEQUE_EMPTY, or DEQUE_ABORT if
+ * another thread took the entry first.
+ */
+int	deque_steal(t_run_deque *q)
+{
+	long	t;
+	long	b;
+	int		id;
+
+	t = atomic_load_explicit(&q->top, memory_order_acquire);
+	atomic_thread_fence(memory_order_seq_cst);
+	b = atomic_load_explicit(&q->bottom, memory_order_acquire);
+	if (t >= b)
+		return (DEQUE_EMPTY);
+	id = atomic_load_explicit(&q->buf[t & q->mask], memory_order_relaxed);
+	if (!atomic_compare_exchange_strong_explicit(&q->top, &t, t + 1,
+			memory_order_seq_cst, memory_order_relaxed))
+		return (DEQUE_ABORT);
+	return (id);
+}
+
+/**
+ * @brief Returns the number of queued philosophers.
+ *
+ * The value is a snapshot and may be stale as soon as it is read.
+ *
+ * @param q Pointer to the deque.
+ * @return long Number of entries between `top` and `bottom`.
+ */
+long	deque_size(t_run_deque *q)
+{
+	long	n;
+
+	n = atomic_load(&q->bottom) - atomic_load(&q->top);
+	if (n < 0)
+		return (0);
+	return (n);
+}
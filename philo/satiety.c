@@ -0,0 +1,92 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   satiety.c                                          :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: imunaev- <imunaev-@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/03/20 11:02:48 by imunaev-          #+#    #+#             */
+/*   Updated: 2025/03/20 11:02:48 by imunaev-         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file satiety.c
+ * @brief Meal accounting: the start of a meal and incremental tracking of
+ * philosophers that reached their meal limit.
+ *
+ * Instead of the monitor counting full philosophers on every tick, each
+ * philosopher bumps a shared atomic counter exactly once, at the meal that
+ * reaches its `meals_limit`. The philosopher that completes the table ends
+ * the simulation right away.
+ */
+
+#include "philo.h"
+#include <limits.h>
+
+/**
+ * @brief Starts a meal: stamps the last meal time and moves the deadline.
+ *
+ * The deadline is the first millisecond at which the philosopher counts
+ * as dead with its own die time. Called once both forks are held.
+ *
+ * Thread safety:
+ * - Uses `meal_mutex` to update the last meal time and the deadline.
+ * - Uses the deadline heap mutex to publish the new death deadline.
+ *
+ * @param p Pointer to the philosopher structure.
+ */
+void	start_meal(t_philo *p)
+{
+	t_env	*env;
+	long	now;
+
+	env = p->env;
+	stat_lock(env, &env->meal_mutex, LOCK_MEAL);
+	now = get_time();
+	env->last_meal[p->id] = now;
+	env->deadline[p->id] = now + p->die_time + 1;
+	pthread_mutex_unlock(&env->meal_mutex);
+	DTRACE_PROBE2(philo, eat_start, p->id + 1, env->meals[p->id] + 1);
+	if (env->meals[p->id] == 0)
+		p->first_meal = now;
+	if (env->opts.monitor_mode == MONITOR_HEAP)
+		deadline_heap_update(env, p->id, now + p->die_time + 1);
+}
+
+/**
+ * @brief Counts a finished meal and signals completion of the table.
+ *
+ * A philosopher that reached its limit stops eating. When `--scenario`
+ * gave the philosophers different limits, the others may eat on for long,
+ * so its deadline is moved to LONG_MAX and the monitor no longer reports
+ * it as starved. With a single limit it stays watched until the run ends.
+ *
+ * Thread safety:
+ * - The philosopher's `meals` entry is only written and read by its owner.
+ * - Uses `meal_mutex` to clear the deadline.
+ * - `satiated` is updated atomically; `end_mutex` protects `ended`.
+ *
+ * @param p Pointer to the philosopher structure.
+ */
+void	count_meal(t_philo *p)
+{
+	DTRACE_PROBE2(philo, eat_end, p->id + 1, p->env->meals[p->id] + 1);
+	p->env->meals[p->id]++;
+	if (p->env->meals[p->id] != p->meals_limit)
+		return ;
+	if (p->env->mixed_limits)
+	{
+		stat_lock(p->env, &p->env->meal_mutex, LOCK_MEAL);
+		p->env->deadline[p->id] = LONG_MAX;
+		pthread_mutex_unlock(&p->env->meal_mutex);
+		if (p->env->opts.monitor_mode == MONITOR_HEAP)
+			deadline_heap_update(p->env, p->id, LONG_MAX);
+	}
+	if (atomic_fetch_add(&p->env->satiated, 1) + 1 < p->env->cfg.num_philo)
+		return ;
+	stat_lock(p->env, &p->env->end_mutex, LOCK_END);
+	p->env->ended = 1;
+	pthread_mutex_unlock(&p->env->end_mutex);
+	wake_monitors(p->env);
+}
@@ -0,0 +1,146 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   scan_kernels.c                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: imunaev- <imunaev-@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/03/26 10:14:37 by imunaev-          #+#    #+#             */
+/*   Updated: 2025/03/26 10:14:37 by imunaev-         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file scan_kernels.c
+ * @brief Vectorized search for a starved philosopher in `deadline`.
+ *
+ * A philosopher is starved once the current time reaches its deadline,
+ * `deadline + die_time + 1` with its own die time, that is when
+ * `deadline < now + 1`. The kernels look for the first such entry in a
+ * range of the dense `deadline` array. The vector kernels compute
+ * `deadline - limit` for several philosophers at once and read the sign
+ * bits, which SSE2 already provides for 64-bit lanes. The best kernel the
+ * CPU supports is chosen at run time.
+ */
+
+#include "philo.h"
+#if defined(__x86_64__)
+# include <immintrin.h>
+#endif
+
+/**
+ * @brief Scalar kernel, used when no vector kernel is available.
+ *
+ * @param deadline The death deadlines.
+ * @param lo First philosopher to check.
+ * @param hi End of the range.
+ * @param limit Deadlines below this are passed.
+ * @return int The first starved philosopher, or `hi` if there is none.
+ */
+static int	scan_scalar(const long *deadline, int lo, int hi, long limit)
+{
+	while (lo < hi && deadline[lo] >= limit)
+		lo++;
+	return (lo);
+}
+
+#if defined(__x86_64__)
+
+/**
+ * @brief SSE2 kernel checking two philosophers per instruction.
+ *
+ * @param deadline The death deadlines.
+ * @param lo First philosopher to check.
+ * @param hi End of the range.
+ * @param limit Deadlines below this are passed.
+ * @return int The first starved philosopher, or `hi` if there is none.
+ */
+static int	scan_sse2(const long *deadline, int lo, int hi, long limit)
+{
+	__m128i	lim;
+	int		mask;
+
+	lim = _mm_set1_epi64x(limit);
+	while (lo + 2 <= hi)
+	{
+		mask = _mm_movemask_pd(_mm_castsi128_pd(_mm_sub_epi64(
+						_mm_loadu_si128((const __m128i *)&deadline[lo]),
+						lim)));
+		if (mask)
+			return (lo + __builtin_ctz(mask));
+		lo += 2;
+	}
+	return (scan_scalar(deadline, lo, hi, limit));
+}
+
+/**
+ * @brief AVX2 kernel checking eight philosophers per iteration, four per
+ * instruction.
+ *
+ * @param deadline The death deadlines.
+ * @param lo First philosopher to check.
+ * @param hi End of the range.
+ * @param limit Deadlines below this are passed.
+ * @return int The first starved philosopher, or `hi` if there is none.
+ */
+__attribute__((target("avx2")))
+static int	scan_avx2(const long *deadline, int lo, int hi, long limit)
+{
+	__m256i	lim;
+	int		mask;
+
+	lim = _mm256_set1_epi64x(limit);
+	while (lo + 8 <= hi)
+	{
+		mask = _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_sub_epi64(
+						_mm256_loadu_si256((const __m256i *)&deadline[lo]),
+						lim)))
+			| _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_sub_epi64(
+						_mm256_loadu_si256((const __m256i *)&deadline[lo + 4]),
+						lim))) << 4;
+		if (mask)
+			return (lo + __builtin_ctz(mask));
+		lo += 8;
+	}
+	return (scan_sse2(deadline, lo, hi, limit));
+}
+
+#endif
+
+/**
+ * @brief Lists the scan kernels the CPU supports, from slowest to fastest.
+ *
+ * @param out Array of at least three entries receiving the kernels.
+ * @return int Number of kernels written to `out`.
+ */
+int	scan_kernels(t_scan_kernel *out)
+{
+	int	n;
+
+	n = 0;
+	out[n].name = "scalar";
+	out[n++].fn = scan_scalar;
+#if defined(__x86_64__)
+	out[n].name = "sse2";
+	out[n++].fn = scan_sse2;
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx2"))
+	{
+		out[n].name = "avx2";
+		out[n++].fn = scan_avx2;
+	}
+#endif
+	return (n);
+}
+
+/**
+ * @brief Selects the fastest scan kernel the CPU supports.
+ *
+ * @return t_scan_kernel The selected kernel.
+ */
+t_scan_kernel	select_scan(void)
+{
+	t_scan_kernel	k[3];
+
+	return (k[scan_kernels(k) - 1]);
+}
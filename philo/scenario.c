@@ -0,0 +1,122 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   scenario.c                                         :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: imunaev- <imunaev-@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 16:20:44 by imunaev-          #+#    #+#             */
+/*   Updated: 2026/10/19 16:20:44 by imunaev-         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file scenario.c
+ * @brief Loading of a `--scenario` file.
+ *
+ * Every philosopher starts from the command-line values; the rules whose
+ * range covers it then override them in file order (see
+ * `apply_scenario()`). The file format is described in
+ * `scenario_parse.c`.
+ */
+
+#include "philo.h"
+
+/**
+ * @brief Parses every line of the scenario text.
+ *
+ * @param sc The scenario being loaded.
+ * @param text The file contents, split in place.
+ * @return int 0 if every line is valid, otherwise the number of the first
+ * invalid line.
+ */
+static int	parse_text(t_scenario *sc, char *text)
+{
+	int	line;
+
+	line = 1;
+	while (*text)
+	{
+		if (parse_rule(sc, next_line(&text)) == EXIT_FAILURE)
+			return (line);
+		line++;
+	}
+	return (0);
+}
+
+/**
+ * @brief Loads the `--scenario` file into `env->scenario`.
+ *
+ * Does nothing without `--scenario`. The seed defaults to 1.
+ *
+ * @param env Pointer to the environment structure.
+ * @return int Returns EXIT_SUCCESS if there is no scenario or every line
+ * is valid, otherwise EXIT_FAILURE.
+ */
+int	load_scenario(t_env *env)
+{
+	char	*text;
+	char	msg[64];
+	int		line;
+
+	if (!env->opts.scenario)
+		return (EXIT_SUCCESS);
+	text = read_file(env->opts.scenario);
+	if (text)
+		env->scenario = calloc(1, sizeof(t_scenario));
+	if (env->scenario)
+		env->scenario->rules = malloc(count_lines(text) * sizeof(t_rule));
+	if (!env->scenario || !env->scenario->rules)
+	{
+		free(text);
+		print_error("Error: load_scenario: cannot read the scenario file\n");
+		return (EXIT_FAILURE);
+	}
+	env->scenario->seed = 1;
+	line = parse_text(env->scenario, text);
+	free(text);
+	if (line == 0)
+		return (EXIT_SUCCESS);
+	snprintf(msg, sizeof(msg), "Error: load_scenario: invalid line %d\n", line);
+	print_error(msg);
+	return (EXIT_FAILURE);
+}
+
+/**
+ * @brief Notes whether the philosophers ended up with different meal
+ * limits.
+ *
+ * With one limit for the whole table, a satiated philosopher stays
+ * watched until the run ends, as without `--scenario`. With mixed limits
+ * it would starve while the others keep eating, so `count_meal()` then
+ * stops watching it.
+ *
+ * @param env Pointer to the environment structure.
+ */
+void	scenario_limits(t_env *env)
+{
+	int	i;
+
+	env->mixed_limits = false;
+	i = 1;
+	while (env->scenario && i < env->cfg.num_philo && !env->mixed_limits)
+	{
+		if (env->philos[i].meals_limit != env->philos[0].meals_limit)
+			env->mixed_limits = true;
+		i++;
+	}
+}
+
+/**
+ * @brief Frees the rules of `--scenario`.
+ *
+ * @param env Pointer to the environment structure.
+ */
+void	free_scenario(t_env *env)
+{
+	if (!env->scenario)
+		return ;
+	free(env->scenario->rules);
+	free(env->scenario);
+	env->scenario = NULL;
+}
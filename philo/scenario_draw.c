@@ -0,0 +1,103 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   scenario_draw.c                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: imunaev- <imunaev-@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 16:31:09 by imunaev-          #+#    #+#             */
+/*   Updated: 2026/10/19 16:31:09 by imunaev-         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file scenario_draw.c
+ * @brief Per-philosopher values drawn from the `--scenario` rules.
+ *
+ * A rule field may draw its value from a distribution. The draws are
+ * hashed from the seed, the rule and the philosopher instead of taken from
+ * a shared generator, so the spawner threads can apply them to their own
+ * slices in parallel and a seed always gives the same table.
+ */
+
+#include "philo.h"
+
+/**
+ * @brief SplitMix64 finalizer, a fast hash with good avalanche.
+ *
+ * @param x The value to hash.
+ * @return uint64_t The hashed value.
+ */
+static uint64_t	mix(uint64_t x)
+{
+	x += 0x9E3779B97F4A7C15ULL;
+	x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+	return (x ^ (x >> 31));
+}
+
+/**
+ * @brief Draws the value of one rule field.
+ *
+ * The normal distribution is approximated by the sum of 12 uniform draws
+ * (Irwin-Hall), which needs no libm and never strays more than 6
+ * deviations from the mean.
+ *
+ * @param d The field.
+ * @param key Hash of the seed, rule, philosopher and field.
+ * @param current The value set before, kept by `DIST_KEEP`.
+ * @return long The drawn value.
+ */
+static long	draw(const t_dist *d, uint64_t key, long current)
+{
+	double	z;
+	int		k;
+
+	if (d->kind == DIST_KEEP)
+		return (current);
+	if (d->kind == DIST_FIXED)
+		return (d->a);
+	if (d->kind == DIST_UNIFORM)
+		return (d->a + (long)(mix(key) % (uint64_t)(d->b - d->a + 1)));
+	z = -6.0;
+	k = 0;
+	while (k < 12)
+	{
+		z += (mix(key + k) >> 11) / 9007199254740992.0;
+		k++;
+	}
+	z = d->a + d->b * z;
+	if (z < 0)
+		return (0);
+	return ((long)(z + 0.5));
+}
+
+/**
+ * @brief Applies every rule that covers philosopher `p`.
+ *
+ * Called by `fillup_philos()` once the command-line values are set.
+ *
+ * @param env Pointer to the environment structure.
+ * @param p Pointer to the philosopher structure.
+ */
+void	apply_scenario(t_env *env, t_philo *p)
+{
+	const t_rule	*r;
+	uint64_t		key;
+	int				i;
+
+	i = 0;
+	while (i < env->scenario->count)
+	{
+		r = &env->scenario->rules[i];
+		if (p->id + 1 >= r->lo && p->id + 1 <= r->hi)
+		{
+			key = mix(env->scenario->seed ^ mix(((uint64_t)i << 32) | p->id));
+			p->die_time = draw(&r->field[0], key, p->die_time);
+			p->eat_time = draw(&r->field[1], key + 16, p->eat_time);
+			p->sleep_time = draw(&r->field[2], key + 32, p->sleep_time);
+			p->meals_limit = draw(&r->field[3], key + 48, p->meals_limit);
+		}
+		i++;
+	}
+}
@@ -0,0 +1,174 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   scenario_parse.c                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: imunaev- <imunaev-@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 16:02:17 by imunaev-          #+#    #+#             */
+/*   Updated: 2026/10/19 16:02:17 by imunaev-         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file scenario_parse.c
+ * @brief Parsing of the lines of a `--scenario` file.
+ *
+ * A rule line is `RANGE die eat sleep [meals]`, where `RANGE` is a
+ * philosopher number, `FIRST-LAST` or `*`, counted from 1. Each field is
+ * `N`, `A..B` (uniform), `A~B` (normal with mean `A` and deviation `B`)
+ * or `-` to keep the value set before; the meal limit may also be `none`
+ * and may be left out. A `seed N` line sets the seed of the draws.
+ */
+
+#include "philo.h"
+#include <limits.h>
+
+/**
+ * @brief Parses a decimal number of at most 9 digits.
+ *
+ * @param s Cursor into the token, moved past the number.
+ * @param out Where to store the number.
+ * @return true if a number was read, otherwise false.
+ */
+static bool	parse_number(char **s, long *out)
+{
+	int	len;
+
+	*out = 0;
+	len = 0;
+	while (**s >= '0' && **s <= '9' && len < 10)
+	{
+		*out = *out * 10 + (**s - '0');
+		(*s)++;
+		len++;
+	}
+	return (len > 0 && len < 10);
+}
+
+/**
+ * @brief Parses one field of a rule.
+ *
+ * @param s The token.
+ * @param d The field to fill.
+ * @param meals Whether the field is the meal limit, which accepts `none`.
+ * @return true if the token is a valid field, otherwise false.
+ */
+static bool	parse_dist(char *s, t_dist *d, bool meals)
+{
+	d->kind = DIST_KEEP;
+	if (s[0] == '-' && s[1] == '\0')
+		return (true);
+	d->kind = DIST_FIXED;
+	d->a = -1;
+	if (meals && ft_strncmp(s, "none", 5) == 0)
+		return (true);
+	if (!parse_number(&s, &d->a))
+		return (false);
+	if (s[0] == '.' && s[1] == '.')
+	{
+		d->kind = DIST_UNIFORM;
+		s += 2;
+		if (!parse_number(&s, &d->b) || d->b < d->a)
+			return (false);
+	}
+	else if (s[0] == '~')
+	{
+		d->kind = DIST_NORMAL;
+		s++;
+		if (!parse_number(&s, &d->b))
+			return (false);
+	}
+	return (s[0] == '\0');
+}
+
+/**
+ * @brief Parses the philosopher range of a rule.
+ *
+ * @param s The token: `N`, `FIRST-LAST` or `*`.
+ * @param r The rule to fill.
+ * @return true if the token is a valid range, otherwise false.
+ */
+static bool	parse_range(char *s, t_rule *r)
+{
+	long	lo;
+	long	hi;
+
+	r->lo = 1;
+	r->hi = INT_MAX;
+	if (s[0] == '*' && s[1] == '\0')
+		return (true);
+	if (!parse_number(&s, &lo) || lo < 1)
+		return (false);
+	hi = lo;
+	if (s[0] == '-')
+	{
+		s++;
+		if (!parse_number(&s, &hi) || hi < lo)
+			return (false);
+	}
+	r->lo = lo;
+	r->hi = hi;
+	return (s[0] == '\0');
+}
+
+/**
+ * @brief Parses the fields of a rule that follow its range.
+ *
+ * @param r The rule to fill.
+ * @param line The rest of the line.
+ * @return true if the die, eat and sleep times are given, the meal limit
+ * is valid or left out, and nothing follows, otherwise false.
+ */
+static bool	parse_fields(t_rule *r, char *line)
+{
+	char	*tok;
+	int		f;
+	bool	meals;
+
+	f = 0;
+	while (f < SCENARIO_FIELDS)
+	{
+		tok = next_token(&line);
+		meals = (f == SCENARIO_FIELDS - 1);
+		r->field[f].kind = DIST_KEEP;
+		if ((tok || !meals) && (!tok || !parse_dist(tok, &r->field[f], meals)))
+			return (false);
+		f++;
+	}
+	return (next_token(&line) == NULL);
+}
+
+/**
+ * @brief Parses one line of a `--scenario` file.
+ *
+ * A rule is appended to `sc->rules`, which has room for one rule per
+ * line; a blank line adds nothing.
+ *
+ * @param sc The scenario being loaded.
+ * @param line The line, without its comment, split in place.
+ * @return int Returns EXIT_SUCCESS if the line is valid, otherwise
+ * EXIT_FAILURE.
+ */
+int	parse_rule(t_scenario *sc, char *line)
+{
+	char	*tok;
+	long	seed;
+
+	tok = next_token(&line);
+	if (!tok)
+		return (EXIT_SUCCESS);
+	if (ft_strncmp(tok, "seed", 5) == 0)
+	{
+		tok = next_token(&line);
+		if (!tok || !parse_number(&tok, &seed) || *tok || next_token(&line))
+			return (EXIT_FAILURE);
+		sc->seed = seed;
+		return (EXIT_SUCCESS);
+	}
+	if (!parse_range(tok, &sc->rules[sc->count])
+		|| !parse_fields(&sc->rules[sc->count], line))
+		return (EXIT_FAILURE);
+	sc->count++;
+	return (EXIT_SUCCESS);
+}
@@ -0,0 +1,148 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   start_gate.c                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: imunaev- <imunaev-@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/03/19 13:02:26 by imunaev-          #+#    #+#             */
+/*   Updated: 2025/03/19 13:02:26 by imunaev-         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file start_gate.c
+ * @brief Synchronized start protocol for the philosopher simulation.
+ *
+ * Philosophers announce readiness on an atomic counter and park on a futex
+ * gate. Once the last one is ready, the main thread picks an absolute start
+ * instant a few milliseconds ahead, opens the gate with a single broadcast,
+ * and every thread waits out the remaining time on its own, so no mutex is
+ * taken on the way in.
+ */
+
+#include "philo.h"
+#include <limits.h>
+#include <sched.h>
+
+/**
+ * @brief Waits until the absolute time `target_us` is reached.
+ *
+ * Sleeps while the target is far away and yields the CPU for the final
+ * stretch, which keeps start skew low without burning a full core.
+ *
+ * @param target_us Absolute time in microseconds.
+ */
+static void	wait_until_us(long target_us)
+{
+	long	left;
+
+	left = target_us - get_time_us();
+	while (left > 0)
+	{
+		if (left > 1000)
+			usleep(left - 500);
+		else
+			sched_yield();
+		left = target_us - get_time_us();
+	}
+}
+
+/**
+ * @brief Registers the calling thread as ready to start.
+ *
+ * Callers are the philosopher threads, or the pool workers when the pool
+ * engine runs the philosophers. The last one to arrive wakes the main
+ * thread.
+ *
+ * @param env Pointer to the environment structure.
+ */
+void	announce_ready(t_env *env)
+{
+	if (atomic_fetch_add(&env->ready_count, 1) + 1 == env->start_expected)
+		futex_wake(&env->ready_count, 1);
+}
+
+/**
+ * @brief Waits for the start gate to open, then for the start instant.
+ *
+ * Thread safety:
+ * - `start_time` and the initial `last_meal` and `deadline` values are
+ *   written before the gate is opened, so they are visible once the gate
+ *   reads as open.
+ *
+ * @param env Pointer to the environment structure.
+ * @return long How late the caller resumed after the start instant, in
+ * microseconds.
+ */
+long	await_start(t_env *env)
+{
+	long	start_us;
+
+	while (atomic_load(&env->start_gate) == 0)
+		futex_wait(&env->start_gate, 0);
+	start_us = env->start_time * 1000;
+	wait_until_us(start_us);
+	return (get_time_us() - start_us);
+}
+
+/**
+ * @brief Publishes the start instant and opens the start gate.
+ *
+ * The deadline heaps and the worker pool are seeded here, while every
+ * other thread is still parked. Also used on failure paths to release
+ * already created threads, in which case `ended` is set and they exit
+ * right away.
+ *
+ * @param env Pointer to the environment structure.
+ * @param start_time Absolute start instant in milliseconds.
+ */
+void	release_start_gate(t_env *env, long start_time)
+{
+	int	i;
+
+	env->start_time = start_time;
+	if (env->live)
+		atomic_store(&env->live->start_time, start_time);
+	i = 0;
+	while (i < env->cfg.num_philo)
+	{
+		env->last_meal[i] = start_time;
+		env->deadline[i] = start_time + env->philos[i].die_time + 1;
+		if (env->philos[i].meals_limit == 0 && env->mixed_limits)
+			env->deadline[i] = LONG_MAX;
+		i++;
+	}
+	i = 0;
+	while (env->opts.monitor_mode == MONITOR_HEAP && i < env->num_shards)
+	{
+		heap_build(&env->shards[i].heap,
+			env->deadline + env->shards[i].heap.base);
+		i++;
+	}
+	if (env->pool)
+		pool_seed(env);
+	atomic_store(&env->start_gate, 1);
+	futex_wake(&env->start_gate, INT_MAX);
+}
+
+/**
+ * @brief Waits until every thread is ready and starts the simulation.
+ *
+ * The start instant is set `START_DELAY_MS` after the last thread
+ * became ready, which leaves time for all of them to wake from the gate.
+ *
+ * @param env Pointer to the environment structure.
+ */
+void	open_start_gate(t_env *env)
+{
+	int	ready;
+
+	ready = atomic_load(&env->ready_count);
+	while (ready < env->start_expected)
+	{
+		futex_wait(&env->ready_count, ready);
+		ready = atomic_load(&env->ready_count);
+	}
+	release_start_gate(env, get_time() + START_DELAY_MS);
+}
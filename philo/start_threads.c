@@ -15,8 +15,8 @@
  * @brief Thread creation and management for the philosopher simulation.
  *
  * This file contains functions responsible for creating threads for
- * philosophers, the monitor, and the logger. It ensures proper thread
- * synchronization and handles failures gracefully.
+ * philosophers and the logger, and for starting the monitor shards. It
+ * ensures proper thread synchronization and handles failures gracefully.
  */
 
 #include "philo.h"
@@ -27,7 +27,8 @@
  * The logger thread (`log_flusher`) is responsible for periodically
  * flushing buffered log entries to standard output.
  *
- * If thread creation fails, the function prints an error message.
+ * If thread creation fails, the function prints an error message. Quiet
+ * runs (batch mode) buffer nothing, so they start no logger thread.
  *
  * Thread safety:
  * - No shared data is modified, so no mutex is required.
@@ -40,6 +41,8 @@
  */
 static int	create_logger_thread(t_env *env, pthread_t *logger_thread)
 {
+	if (env->opts.quiet)
+		return (EXIT_SUCCESS);
 	if (pthread_create(logger_thread, NULL, &log_flusher, env) != 0)
 	{
 		print_error("Error: Failed to create logger thread\n");
@@ -50,44 +53,87 @@ static int	create_logger_thread(t_env *env, pthread_t *logger_thread)
 }
 
 /**
- * @brief Creates the monitor thread.
+ * @brief Spawner function creating the philosopher threads of one slice.
  *
- * The monitor thread continuously checks for philosopher deaths and
- * whether all philosophers have eaten enough meals. If thread creation
- * fails, it sets `env->ended` to true to signal termination.
+ * Each thread gets the small stack from `init_thread_attr()`. Creation
+ * stops at the first failure; `done` then counts the threads created.
+ *
+ * @param arg Pointer to the slice (`t_spawner`).
+ * @return NULL when the slice is done.
+ */
+static void	*spawn_slice(void *arg)
+{
+	t_spawner		*sp;
+	pthread_attr_t	attr;
+	t_philo			*p;
+
+	sp = (t_spawner *)arg;
+	sp->status = init_thread_attr(sp->env->cfg.num_philo, &attr);
+	if (sp->status == EXIT_FAILURE)
+		return (NULL);
+	while (sp->lo + sp->done < sp->hi)
+	{
+		p = &sp->env->philos[sp->lo + sp->done];
+		if (pthread_create(&p->thread, &attr, routine, p) != 0)
+		{
+			sp->status = EXIT_FAILURE;
+			break ;
+		}
+		place_thread(sp->env, p->thread, p->id);
+		sp->done++;
+	}
+	(void)pthread_attr_destroy(&attr);
+	return (NULL);
+}
+
+/**
+ * @brief Stops the simulation after a philosopher thread failed to start.
+ *
+ * Sets `env->ended` to true, opens the start gate so that waiting threads
+ * can exit, and joins the philosopher threads each slice created. Crew
+ * members are not joined; `join_threads()` waits for them.
  *
  * Thread safety:
  * - Uses `end_mutex` to safely update the `ended` flag.
  *
  * @param env Pointer to the environment structure.
- * @param mon Pointer to the `pthread_t` variable for the monitor thread.
- * @return int Returns EXIT_SUCCESS if the thread is created successfully,
- * otherwise EXIT_FAILURE.
+ * @param sp The slices.
+ * @param n Number of slices.
  */
-static int	create_monitor_thread(t_env *env, pthread_t *mon)
+static void	abort_philosophers(t_env *env, t_spawner *sp, int n)
 {
-	if (pthread_create(mon, NULL, monitor, env) != 0)
+	int	i;
+	int	k;
+
+	print_error("Error: Failed to create philosopher thread\n");
+	stat_lock(env, &env->end_mutex, LOCK_END);
+	env->ended = true;
+	pthread_mutex_unlock(&env->end_mutex);
+	wake_monitors(env);
+	release_start_gate(env, get_time());
+	k = 0;
+	while (!env->crew && k < n)
 	{
-		print_error("Error: Failed to create monitor thread\n");
-		pthread_mutex_lock(&env->end_mutex);
-		env->ended = true;
-		pthread_mutex_unlock(&env->end_mutex);
-		return (EXIT_FAILURE);
+		i = sp[k].lo;
+		while (i < sp[k].lo + sp[k].done)
+		{
+			pthread_join(env->philos[i].thread, NULL);
+			i++;
+		}
+		k++;
 	}
-	env->t_mon_created = true;
-	return (EXIT_SUCCESS);
 }
 
 /**
  * @brief Creates philosopher threads.
  *
- * This function initializes a thread for each philosopher to run their
- * routine concurrently. If a thread fails to create, it sets `env->ended`
- * to true and joins all previously created philosopher threads to ensure
- * proper cleanup.
- *
- * Thread safety:
- * - Uses `end_mutex` to safely update the `ended` flag upon failure.
+ * This function starts a thread for each philosopher to run their routine
+ * concurrently. The threads are created by spawner threads, one per slice
+ * of philosophers (see `run_spawners()`), so startup does not grow
+ * linearly on the main thread. In a `--batch` run the philosophers are
+ * handed to the runner's crew instead (see `crew_slice()`). If a thread
+ * fails to create, the threads created so far are stopped and joined to
+ * ensure proper cleanup.
  *
  * @param env Pointer to the environment structure.
  * @return int Returns EXIT_SUCCESS if all threads are created successfully,
@@ -95,23 +141,19 @@ static int	create_monitor_thread(t_env *env, pthread_t *mon)
  */
 static int	create_philosopher_threads(t_env *env)
 {
-	int	i;
+	t_spawner	sp[MAX_SPAWNERS];
+	long		t0;
 
-	i = 0;
-	while (i < env->num_philo)
+	t0 = get_time_us();
+	if (env->crew)
+		env->num_spawners = run_spawners(env, sp, crew_slice);
+	else
+		env->num_spawners = run_spawners(env, sp, spawn_slice);
+	env->spawn_us = get_time_us() - t0;
+	if (spawners_failed(sp, env->num_spawners))
 	{
-		if (pthread_create(&env->philos[i].thread, NULL,
-				routine, &env->philos[i]) != 0)
-		{
-			print_error("Error: Failed to create philosopher thread\n");
-			pthread_mutex_lock(&env->end_mutex);
-			env->ended = true;
-			pthread_mutex_unlock(&env->end_mutex);
-			while (--i >= 0)
-				pthread_join(env->philos[i].thread, NULL);
-			return (EXIT_FAILURE);
-		}
-		i++;
+		abort_philosophers(env, sp, env->num_spawners);
+		return (EXIT_FAILURE);
 	}
 	env->t_philos_created = true;
 	return (EXIT_SUCCESS);
@@ -122,42 +164,44 @@ static int	create_philosopher_threads(t_env *env)
  *
  * This function creates the logger, monitor, and philosopher threads
  * while ensuring proper synchronization. If any thread creation fails,
- * it releases the `start_mutex` and returns an error.
+ * it returns an error.
  *
  * Steps:
  * - Creates the logger thread.
- * - Creates the monitor thread.
- * - Creates philosopher threads.
- * - Unlocks `start_mutex` and sets `start_time` when all threads are ready.
+ * - Creates the monitor shard threads.
+ * - Creates philosopher threads, or the pool workers with `--engine=pool`,
+ *   or the coroutine carriers with `--engine=coro`.
+ * - Opens the start gate and sets `start_time` when all threads are ready.
+ * - With `--report`, prints the memory used once all threads exist.
+ *
+ * In a `--batch` run the monitor, worker, carrier and philosopher
+ * "threads" are members of the runner's crew (see `crew.c`).
  *
  * Thread safety:
- * - Uses `start_mutex` to synchronize thread start timing.
+ * - Uses the start gate to synchronize thread start timing.
  *
  * @param env Pointer to the environment structure.
- * @param mon Pointer to the `pthread_t` variable for the monitor thread.
  * @param logger_thread Pointer to the `pthread_t` variable for the logger
  * thread.
  * @return int Returns EXIT_SUCCESS if all threads start successfully,
  * otherwise EXIT_FAILURE.
  */
-int	start_threads(t_env *env, pthread_t *mon, pthread_t *logger_thread)
+int	start_threads(t_env *env, pthread_t *logger_thread)
 {
-	pthread_mutex_lock(&env->start_mutex);
 	if (create_logger_thread(env, logger_thread) == EXIT_FAILURE)
-	{
-		pthread_mutex_unlock(&env->start_mutex);
 		return (EXIT_FAILURE);
-	}
-	if (create_monitor_thread(env, mon) == EXIT_FAILURE)
-	{
-		pthread_mutex_unlock(&env->start_mutex);
+	if (create_monitor_threads(env) == EXIT_FAILURE)
 		return (EXIT_FAILURE);
-	}
-	if (create_philosopher_threads(env) == EXIT_FAILURE)
-	{
-		pthread_mutex_unlock(&env->start_mutex);
+	if (env->opts.engine == ENGINE_POOL
+		&& create_pool_workers(env) == EXIT_FAILURE)
 		return (EXIT_FAILURE);
-	}
-	pthread_mutex_unlock(&env->start_mutex);
+	if (env->opts.engine == ENGINE_CORO
+		&& create_coro_carriers(env) == EXIT_FAILURE)
+		return (EXIT_FAILURE);
+	if (env->opts.engine == ENGINE_THREAD
+		&& create_philosopher_threads(env) == EXIT_FAILURE)
+		return (EXIT_FAILURE);
+	open_start_gate(env);
+	report_memory(env);
 	return (EXIT_SUCCESS);
 }
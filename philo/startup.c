@@ -0,0 +1,157 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   startup.c                                          :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: imunaev- <imunaev-@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/03/25 09:54:20 by imunaev-          #+#    #+#             */
+/*   Updated: 2025/03/25 09:54:20 by imunaev-         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file startup.c
+ * @brief Fan-out of startup work over spawner threads.
+ *
+ * Initializing and creating tens of thousands of philosophers from the
+ * main thread alone makes startup grow linearly with their number. The
+ * work is split into slices of about `SPAWN_SLICE` philosophers instead,
+ * each handled by its own spawner thread, so the main thread only creates
+ * the spawners.
+ */
+
+#include "philo.h"
+#include <limits.h>
+
+/**
+ * @brief Returns the number of slices to split the philosophers into.
+ *
+ * @param env Pointer to the environment structure.
+ * @return int Between 1 and `MAX_SPAWNERS`.
+ */
+static int	spawner_count(t_env *env)
+{
+	int	n;
+
+	n = (env->cfg.num_philo + SPAWN_SLICE - 1) / SPAWN_SLICE;
+	if (n > MAX_SPAWNERS)
+		n = MAX_SPAWNERS;
+	return (n);
+}
+
+/**
+ * @brief Starts slice `i` of `n` on its own spawner thread.
+ *
+ * The spawner is pinned like the philosophers it serves. A single slice,
+ * a slice whose spawner fails to start, or any slice of a `--batch` run,
+ * whose crew only takes tasks from its runner, runs on the calling thread
+ * instead.
+ *
+ * @param sp The slice to fill and start.
+ * @param i Index of the slice.
+ * @param n Number of slices.
+ * @param fn Spawner function, called with a pointer to its slice.
+ */
+static void	start_spawner(t_spawner *sp, int i, int n, void *(*fn)(void *))
+{
+	sp->lo = (long)i * sp->env->cfg.num_philo / n;
+	sp->hi = (long)(i + 1) * sp->env->cfg.num_philo / n;
+	sp->done = 0;
+	sp->status = EXIT_SUCCESS;
+	sp->created = (n > 1 && !sp->env->crew
+			&& pthread_create(&sp->thread, NULL, fn, sp) == 0);
+	if (sp->created)
+		place_thread(sp->env, sp->thread, sp->lo);
+	else
+		(void)fn(sp);
+}
+
+/**
+ * @brief Runs `fn` on every slice of philosophers and waits for all of
+ * them.
+ *
+ * @param env Pointer to the environment structure.
+ * @param sp Array of at least `MAX_SPAWNERS` slices to fill.
+ * @param fn Spawner function, called with a pointer to its slice.
+ * @return int Number of slices.
+ */
+int	run_spawners(t_env *env, t_spawner *sp, void *(*fn)(void *))
+{
+	int	n;
+	int	i;
+
+	n = spawner_count(env);
+	i = 0;
+	while (i < n)
+	{
+		sp[i].env = env;
+		start_spawner(&sp[i], i, n, fn);
+		i++;
+	}
+	i = 0;
+	while (i < n)
+	{
+		if (sp[i].created)
+			pthread_join(sp[i].thread, NULL);
+		i++;
+	}
+	return (n);
+}
+
+/**
+ * @brief Tells whether any slice failed.
+ *
+ * @param sp The slices.
+ * @param n Number of slices.
+ * @return true if a slice reported EXIT_FAILURE.
+ */
+bool	spawners_failed(t_spawner *sp, int n)
+{
+	int	i;
+
+	i = 0;
+	while (i < n)
+	{
+		if (sp[i].status == EXIT_FAILURE)
+			return (true);
+		i++;
+	}
+	return (false);
+}
+
+/**
+ * @brief Reports how long after launch the first and the last philosopher
+ * had their first meal.
+ *
+ * Times are measured from program launch, so they include initialization
+ * and thread creation as well as the start gate.
+ *
+ * @param env Pointer to the environment structure.
+ */
+void	report_first_meal(t_env *env)
+{
+	long	first;
+	long	last;
+	int		hungry;
+	int		i;
+
+	first = LONG_MAX;
+	last = 0;
+	hungry = 0;
+	i = 0;
+	while (i < env->cfg.num_philo)
+	{
+		if (env->philos[i].first_meal == 0)
+			hungry++;
+		else if (env->philos[i].first_meal < first)
+			first = env->philos[i].first_meal;
+		if (env->philos[i].first_meal > last)
+			last = env->philos[i].first_meal;
+		i++;
+	}
+	if (hungry < env->cfg.num_philo)
+		fprintf(stderr, "time to first meal: first %ld ms, last %ld ms "
+			"(%d never ate)\n", first - env->launch_time,
+			last - env->launch_time, hungry);
+}
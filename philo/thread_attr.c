@@ -0,0 +1,163 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   thread_attr.c                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: imunaev- <imunaev-@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/03/24 11:18:06 by imunaev-          #+#    #+#             */
+/*   Updated: 2025/03/24 11:18:06 by imunaev-         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file thread_attr.c
+ * @brief Stack and guard configuration of philosopher threads.
+ *
+ * With default attributes every philosopher thread reserves the process
+ * stack limit (usually 8 MB) of address space. A philosopher only needs a
+ * few frames, so its threads are created with a small computed stack,
+ * which lets thread-per-philosopher mode scale to tens of thousands of
+ * philosophers.
+ */
+
+#include "philo.h"
+#include <fcntl.h>
+#include <limits.h>
+
+/**
+ * @brief Reads a small `/proc` file into `buf`.
+ *
+ * @param path Path of the file.
+ * @param buf Buffer receiving the NUL-terminated contents.
+ * @param size Size of `buf`.
+ * @return int Returns EXIT_SUCCESS if something was read, otherwise
+ * EXIT_FAILURE.
+ */
+static int	read_proc(const char *path, char *buf, size_t size)
+{
+	ssize_t	len;
+	int		fd;
+
+	fd = open(path, O_RDONLY);
+	if (fd < 0)
+		return (EXIT_FAILURE);
+	len = read(fd, buf, size - 1);
+	close(fd);
+	if (len <= 0)
+		return (EXIT_FAILURE);
+	buf[len] = '\0';
+	return (EXIT_SUCCESS);
+}
+
+/**
+ * @brief Returns the stack size given to each philosopher thread.
+ *
+ * This is the C library's minimum for a thread (which also covers its
+ * thread-local storage) plus `PHILO_STACK_RESERVE` for the routine's own
+ * frames, rounded up to whole pages.
+ *
+ * @return size_t Stack size in bytes.
+ */
+size_t	philo_stack_size(void)
+{
+	long	min;
+	long	page;
+
+	min = sysconf(_SC_THREAD_STACK_MIN);
+	if (min < PTHREAD_STACK_MIN)
+		min = PTHREAD_STACK_MIN;
+	page = sysconf(_SC_PAGESIZE);
+	return ((min + PHILO_STACK_RESERVE + page - 1) / page * page);
+}
+
+/**
+ * @brief Returns the guard size for `threads` small-stack threads.
+ *
+ * A guard page splits every thread stack into two memory mappings. When
+ * that would exceed `vm.max_map_count`, thread creation would fail long
+ * before memory runs out, so the guard page is dropped.
+ *
+ * @param threads Number of threads created with these attributes.
+ * @return size_t One page, or 0 for very large thread counts.
+ */
+static size_t	guard_size(long threads)
+{
+	char	buf[32];
+	long	max_maps;
+
+	max_maps = 65530;
+	if (read_proc("/proc/sys/vm/max_map_count", buf, sizeof(buf))
+		== EXIT_SUCCESS)
+		max_maps = ft_atoi(buf);
+	if (2 * threads + PHILO_MAP_MARGIN > max_maps)
+		return (0);
+	return (sysconf(_SC_PAGESIZE));
+}
+
+/**
+ * @brief Initializes the attributes used to create philosopher threads.
+ *
+ * `--batch` runners also create their crew threads (see `crew.c`) with
+ * them.
+ *
+ * @param threads Number of threads created with these attributes, which
+ * decides the guard size.
+ * @param attr Attributes to initialize; destroyed by the caller.
+ * @return int Returns EXIT_SUCCESS if the attributes are set, otherwise
+ * EXIT_FAILURE.
+ */
+int	init_thread_attr(long threads, pthread_attr_t *attr)
+{
+	if (pthread_attr_init(attr) != 0)
+	{
+		print_error("Error: Failed to initialize thread attributes\n");
+		return (EXIT_FAILURE);
+	}
+	if (pthread_attr_setstacksize(attr, philo_stack_size()) != 0
+		|| pthread_attr_setguardsize(attr, guard_size(threads)) != 0)
+	{
+		print_error("Error: Failed to set thread stack attributes\n");
+		(void)pthread_attr_destroy(attr);
+		return (EXIT_FAILURE);
+	}
+	return (EXIT_SUCCESS);
+}
+
+/**
+ * @brief Reports the process memory once all threads are started.
+ *
+ * Uses the virtual and resident sizes from `/proc/self/statm`, also
+ * divided by the number of philosophers, and the size and page backing of
+ * the arena.
+ *
+ * @param env Pointer to the environment structure.
+ */
+void	report_memory(t_env *env)
+{
+	static const char *const	backing[] = {"base pages",
+		"transparent huge pages", "huge pages"};
+	char						buf[128];
+	const char					*s;
+	long						kb;
+	long						virt;
+	long						rss;
+
+	if (!env->opts.report
+		|| read_proc("/proc/self/statm", buf, sizeof(buf)) == EXIT_FAILURE)
+		return ;
+	kb = sysconf(_SC_PAGESIZE) / 1024;
+	virt = ft_atoi(buf) * kb;
+	s = buf;
+	while (*s && *s != ' ')
+		s++;
+	rss = ft_atoi(s) * kb;
+	fprintf(stderr, "memory at start: virtual %ld KB, resident %ld KB; "
+		"per philosopher %ld KB virtual, %ld KB resident\n", virt, rss,
+		virt / env->cfg.num_philo, rss / env->cfg.num_philo);
+	fprintf(stderr, "arena: %zu KB, %s\n", env->arena.size / 1024,
+		backing[env->arena.backing]);
+	if (env->opts.engine == ENGINE_THREAD)
+		fprintf(stderr, "philosopher stack: %zu KB\n",
+			philo_stack_size() / 1024);
+}
@@ -0,0 +1,113 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   philo_top.c                                        :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: imunaev- <imunaev-@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/03/28 17:14:50 by imunaev-          #+#    #+#             */
+/*   Updated: 2025/03/28 17:14:50 by imunaev-         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file philo_top.c
+ * @brief Entry point of `philo-top`, the live viewer of a `--live` run.
+ *
+ * Usage: `./philo-top <pid> [refresh_ms]`. The segment of that run is
+ * mapped read-only and redrawn until the run ends; the simulation itself
+ * is never signalled or paused.
+ */
+
+#include "philo_top.h"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/**
+ * @brief Maps the segment of run `pid` read-only.
+ *
+ * @param t Pointer to the viewer state.
+ * @return int Returns EXIT_SUCCESS on success, otherwise EXIT_FAILURE.
+ */
+static int	top_open(t_top *t)
+{
+	char		name[32];
+	struct stat	st;
+	void		*map;
+	int			fd;
+
+	snprintf(name, sizeof(name), "%s%d", LIVE_PREFIX, t->pid);
+	fd = shm_open(name, O_RDONLY, 0);
+	if (fd < 0)
+		return (EXIT_FAILURE);
+	map = MAP_FAILED;
+	if (fstat(fd, &st) == 0 && (size_t)st.st_size >= sizeof(t_live_header))
+		map = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);
+	if (map == MAP_FAILED)
+		return (EXIT_FAILURE);
+	t->h = map;
+	t->size = st.st_size;
+	t->slots = (t_live_slot *)((char *)map + (sizeof(t_live_header)
+				+ CACHE_LINE - 1) / CACHE_LINE * CACHE_LINE);
+	if (t->h->magic != LIVE_MAGIC || (char *)(t->slots + t->h->num_philo)
+		> (char *)map + t->size)
+		return (EXIT_FAILURE);
+	return (EXIT_SUCCESS);
+}
+
+/**
+ * @brief Redraws the screen every `refresh_ms` until the run ends.
+ *
+ * @param t Pointer to the viewer state.
+ * @param refresh_ms Time between two refreshes.
+ */
+static void	top_loop(t_top *t, long refresh_ms)
+{
+	while (true)
+	{
+		top_snapshot(t);
+		top_render(t);
+		if (atomic_load(&t->h->ended))
+			return ;
+		usleep(refresh_ms * 1000);
+	}
+}
+
+/**
+ * @brief Maps the segment of the given run and watches it until it ends.
+ *
+ * @param ac Argument count.
+ * @param av Argument vector: the pid of the run and an optional refresh
+ * period in milliseconds.
+ * @return int Returns EXIT_SUCCESS, or EXIT_FAILURE if the run has no
+ * segment.
+ */
+int	main(int ac, char **av)
+{
+	t_top	t;
+	long	refresh_ms;
+
+	if (ac < 2 || ac > 3 || ft_atoi(av[1]) <= 0)
+	{
+		print_error("Usage: ./philo-top <pid> [refresh_ms]\n");
+		return (EXIT_FAILURE);
+	}
+	memset(&t, 0, sizeof(t));
+	t.pid = ft_atoi(av[1]);
+	refresh_ms = TOP_REFRESH_MS;
+	if (ac == 3 && ft_atoi(av[2]) > 0)
+		refresh_ms = ft_atoi(av[2]);
+	if (top_open(&t) == EXIT_FAILURE)
+	{
+		print_error("Error: philo-top: no live stats for that pid\n");
+		return (EXIT_FAILURE);
+	}
+	t.snap = malloc(t.h->num_philo * sizeof(t_live_slot));
+	if (t.snap)
+		top_loop(&t, refresh_ms);
+	free(t.snap);
+	munmap(t.h, t.size);
+	return (EXIT_SUCCESS);
+}
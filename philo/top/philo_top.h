@@ -0,0 +1,46 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   philo_top.h                                        :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: imunaev- <imunaev-@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/03/28 17:10:26 by imunaev-          #+#    #+#             */
+/*   Updated: 2025/03/28 17:10:26 by imunaev-         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef PHILO_TOP_H
+# define PHILO_TOP_H
+
+# include "../philo.h"
+
+# define TOP_REFRESH_MS 500
+# define TOP_HUNGRIEST 10
+# define TOP_WAITERS 5
+
+/**
+ * @struct s_top
+ * @brief State of the `philo-top` viewer.
+ *
+ * `h` and `slots` point into the read-only mapping of the segment; `snap`
+ * is the private copy taken at each refresh. `prev_meals` and `prev_ms`
+ * are the meal total and time of the previous refresh, for throughput.
+ */
+typedef struct s_top
+{
+	int				pid;
+	t_live_header	*h;
+	t_live_slot		*slots;
+	t_live_slot		*snap;
+	size_t			size;
+	long			prev_meals;
+	long			prev_ms;
+}	t_top;
+
+long	top_now_ms(void);
+void	top_snapshot(t_top *t);
+void	top_render(t_top *t);
+void	top_render_locks(t_top *t);
+
+#endif
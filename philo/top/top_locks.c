@@ -0,0 +1,50 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   top_locks.c                                        :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: imunaev- <imunaev-@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/03/28 18:40:13 by imunaev-          #+#    #+#             */
+/*   Updated: 2025/03/28 18:40:13 by imunaev-         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file top_locks.c
+ * @brief Fork contention panel of `philo-top`.
+ *
+ * Only drawn for runs started with `--lockstat` and mutex forks, whose
+ * philosophers publish their fork counters in their slots.
+ */
+
+#include "philo_top.h"
+
+/**
+ * @brief Draws the fork contention totals of a `--lockstat` run.
+ *
+ * @param t Pointer to the viewer state.
+ */
+void	top_render_locks(t_top *t)
+{
+	long	contended;
+	long	wait_ns;
+	int		worst;
+	int		i;
+
+	contended = 0;
+	wait_ns = 0;
+	worst = 0;
+	i = 0;
+	while (i < t->h->num_philo)
+	{
+		contended += t->snap[i].contended;
+		wait_ns += t->snap[i].wait_ns;
+		if (t->snap[i].wait_ns > t->snap[worst].wait_ns)
+			worst = i;
+		i++;
+	}
+	printf("forks: %ld contended takes, %ld us waited; longest waiter "
+		"philo %d (%ld us)\n", contended, wait_ns / 1000, worst + 1,
+		t->snap[worst].wait_ns / 1000);
+}
@@ -0,0 +1,168 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   top_render.c                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: imunaev- <imunaev-@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/03/28 18:05:39 by imunaev-          #+#    #+#             */
+/*   Updated: 2025/03/28 18:05:39 by imunaev-         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file top_render.c
+ * @brief Drawing of the `philo-top` screen.
+ *
+ * The screen shows the run parameters and status, meal throughput since
+ * the previous refresh, how many philosophers are in each state, the
+ * philosophers closest to their own deadline and, with `--lockstat`, fork
+ * contention.
+ */
+
+#include "philo_top.h"
+
+/**
+ * @brief Draws the run summary and the state counts.
+ *
+ * @param t Pointer to the viewer state.
+ * @param now Current time in milliseconds.
+ */
+static void	render_summary(t_top *t, long now)
+{
+	int		states[LIVE_THINKING + 1];
+	long	meals;
+	long	dt;
+	int		i;
+
+	memset(states, 0, sizeof(states));
+	meals = 0;
+	i = 0;
+	while (i < t->h->num_philo)
+	{
+		meals += t->snap[i].meals;
+		if (t->snap[i].state >= 0 && t->snap[i].state <= LIVE_THINKING)
+			states[t->snap[i].state]++;
+		i++;
+	}
+	dt = now - t->prev_ms;
+	if (dt < 1)
+		dt = 1;
+	printf("%ld meals, %ld meals/s, elapsed %ld ms\n", meals,
+		(meals - t->prev_meals) * 1000 / dt,
+		now - atomic_load(&t->h->start_time));
+	printf("%d eating, %d sleeping, %d thinking, %d taking forks, "
+		"%d not started\n", states[LIVE_EATING], states[LIVE_SLEEPING],
+		states[LIVE_THINKING], states[LIVE_FORK], states[LIVE_WAITING]);
+	t->prev_meals = meals;
+}
+
+/**
+ * @brief Returns the philosopher with the nearest deadline that is not
+ * eating, is still hungry and has not been listed yet.
+ *
+ * Deadlines and meal limits are each philosopher's own, so a
+ * `--scenario` run lists the philosophers that are really closest to
+ * starving.
+ *
+ * @param t Pointer to the viewer state.
+ * @return int Index of that philosopher, or -1.
+ */
+static int	next_hungriest(t_top *t)
+{
+	t_live_slot	*s;
+	int			best;
+	int			i;
+
+	best = -1;
+	i = 0;
+	while (i < t->h->num_philo)
+	{
+		s = &t->snap[i];
+		if (s->state != LIVE_EATING && s->state != -1
+			&& (s->meals_limit < 0 || s->meals < s->meals_limit)
+			&& (best < 0 || s->last_meal + s->die_time
+				< t->snap[best].last_meal + t->snap[best].die_time))
+			best = i;
+		i++;
+	}
+	return (best);
+}
+
+/**
+ * @brief Draws the `TOP_HUNGRIEST` philosophers closest to starving.
+ *
+ * Listed philosophers are marked in the snapshot so they are not listed
+ * twice.
+ *
+ * @param t Pointer to the viewer state.
+ * @param now Current time in milliseconds.
+ */
+static void	render_hungriest(t_top *t, long now)
+{
+	static const char *const	names[] = {"waiting", "forks", "eating",
+		"sleeping", "thinking"};
+	long						since;
+	int							rows;
+	int							i;
+
+	printf("\n%8s %10s %10s %8s  %s\n", "philo", "hungry ms", "margin ms",
+		"meals", "state");
+	rows = 0;
+	i = next_hungriest(t);
+	while (rows < TOP_HUNGRIEST && i >= 0)
+	{
+		since = t->snap[i].last_meal;
+		printf("%8d %10ld %10ld %8d  %s\n", i + 1, now - since,
+			t->snap[i].die_time - (now - since), t->snap[i].meals,
+			names[t->snap[i].state]);
+		t->snap[i].state = -1;
+		i = next_hungriest(t);
+		rows++;
+	}
+}
+
+/**
+ * @brief Clears the screen and draws the run parameters and status.
+ *
+ * @param t Pointer to the viewer state.
+ */
+static void	render_title(t_top *t)
+{
+	printf("\033[H\033[2Jphilo-top: pid %d, %d philosophers, %ld %ld %ld",
+		t->pid, t->h->num_philo, t->h->die_time, t->h->eat_time,
+		t->h->sleep_time);
+	if (t->h->meals_limit >= 0)
+		printf(" %d", t->h->meals_limit);
+	if (atomic_load(&t->h->died))
+		printf(" - philosopher %d died", atomic_load(&t->h->died));
+	else if (atomic_load(&t->h->ended))
+		printf(" - ended");
+	else if (atomic_load(&t->h->start_time) == 0)
+		printf(" - waiting for the start gate");
+	printf("\n");
+}
+
+/**
+ * @brief Redraws the whole screen from the last snapshot.
+ *
+ * @param t Pointer to the viewer state.
+ */
+void	top_render(t_top *t)
+{
+	long	now;
+
+	now = top_now_ms();
+	render_title(t);
+	if (atomic_load(&t->h->start_time) != 0)
+	{
+		if (t->prev_ms == 0)
+			t->prev_ms = atomic_load(&t->h->start_time);
+		render_summary(t, now);
+		t->prev_ms = now;
+		if (t->h->fork_stats)
+			top_render_locks(t);
+		render_hungriest(t, now);
+	}
+	fflush(stdout);
+}
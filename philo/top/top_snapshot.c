@@ -0,0 +1,80 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   top_snapshot.c                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: imunaev- <imunaev-@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/03/28 17:31:08 by imunaev-          #+#    #+#             */
+/*   Updated: 2025/03/28 17:31:08 by imunaev-         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file top_snapshot.c
+ * @brief Consistent copies of the philosophers' seqlocked slots.
+ */
+
+#include "philo_top.h"
+
+/**
+ * @brief Returns the wall-clock time in milliseconds, on the same clock as
+ * the simulation's `get_time()`.
+ */
+long	top_now_ms(void)
+{
+	struct timeval	tv;
+
+	gettimeofday(&tv, NULL);
+	return (tv.tv_sec * 1000 + tv.tv_usec / 1000);
+}
+
+/**
+ * @brief Copies one slot, retrying while its philosopher is writing it.
+ *
+ * @param src The slot in the shared segment.
+ * @param dst The private copy.
+ */
+static void	read_slot(const t_live_slot *src, t_live_slot *dst)
+{
+	unsigned int	before;
+	unsigned int	after;
+
+	while (true)
+	{
+		before = atomic_load_explicit(&src->seq, memory_order_acquire);
+		dst->state = src->state;
+		dst->meals = src->meals;
+		dst->last_meal = src->last_meal;
+		dst->contended = src->contended;
+		dst->wait_ns = src->wait_ns;
+		dst->die_time = src->die_time;
+		dst->meals_limit = src->meals_limit;
+		atomic_thread_fence(memory_order_acquire);
+		after = atomic_load_explicit(&src->seq, memory_order_relaxed);
+		if (!(before & 1) && before == after)
+			return ;
+	}
+}
+
+/**
+ * @brief Takes a snapshot of every philosopher's slot.
+ *
+ * A philosopher that has not eaten yet is given the start time as its
+ * last meal, from which its deadline counts.
+ *
+ * @param t Pointer to the viewer state.
+ */
+void	top_snapshot(t_top *t)
+{
+	int	i;
+
+	i = 0;
+	while (i < t->h->num_philo)
+	{
+		read_slot(&t->slots[i], &t->snap[i]);
+		if (t->snap[i].last_meal == 0)
+			t->snap[i].last_meal = atomic_load(&t->h->start_time);
+		i++;
+	}
+}
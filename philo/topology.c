@@ -0,0 +1,178 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   topology.c                                         :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: imunaev- <imunaev-@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/03/23 14:02:39 by imunaev-          #+#    #+#             */
+/*   Updated: 2025/03/23 14:02:39 by imunaev-         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file topology.c
+ * @brief CPU and NUMA topology discovery from sysfs.
+ *
+ * Reads `/sys/devices/system/node/node<N>/cpulist` for every node and keeps
+ * the CPUs this process is allowed to run on. Without NUMA information in
+ * sysfs, all allowed CPUs form a single node.
+ */
+
+#define _GNU_SOURCE
+#include "philo.h"
+#include <fcntl.h>
+#include <sched.h>
+
+/**
+ * @brief Parses a decimal number and advances past it.
+ *
+ * @param s Pointer to the cursor in the string.
+ * @return int The parsed number.
+ */
+static int	read_number(const char **s)
+{
+	int	n;
+
+	n = 0;
+	while (**s >= '0' && **s <= '9' && n < MAX_CPUS)
+	{
+		n = n * 10 + (**s - '0');
+		(*s)++;
+	}
+	while (**s >= '0' && **s <= '9')
+		(*s)++;
+	return (n);
+}
+
+/**
+ * @brief Adds the allowed CPUs of a cpulist such as `0-3,8,10-11` to the
+ * group being read.
+ *
+ * @param t Pointer to the topology.
+ * @param s The cpulist text.
+ * @param allowed CPUs this process may run on.
+ */
+static void	parse_cpulist(t_topology *t, const char *s, cpu_set_t *allowed)
+{
+	int	lo;
+	int	hi;
+
+	while (*s >= '0' && *s <= '9')
+	{
+		lo = read_number(&s);
+		hi = lo;
+		if (*s == '-')
+		{
+			s++;
+			hi = read_number(&s);
+		}
+		while (lo <= hi && lo < MAX_CPUS)
+		{
+			if (CPU_ISSET(lo, allowed) && t->cpu_node[lo] < 0)
+			{
+				t->cpu_node[lo] = t->num_nodes;
+				t->cpus[t->num_cpus] = lo;
+				t->num_cpus++;
+			}
+			lo++;
+		}
+		if (*s == ',')
+			s++;
+	}
+}
+
+/**
+ * @brief Reads the CPUs of NUMA node `node` as a new group.
+ *
+ * Missing nodes and nodes without allowed CPUs add no group.
+ *
+ * @param t Pointer to the topology.
+ * @param node NUMA node number.
+ * @param allowed CPUs this process may run on.
+ */
+static void	read_node(t_topology *t, int node, cpu_set_t *allowed)
+{
+	char	path[64];
+	char	buf[4096];
+	ssize_t	len;
+	int		fd;
+
+	snprintf(path, sizeof(path), "/sys/devices/system/node/node%d/cpulist",
+		node);
+	fd = open(path, O_RDONLY);
+	if (fd < 0)
+		return ;
+	len = read(fd, buf, sizeof(buf) - 1);
+	close(fd);
+	if (len <= 0)
+		return ;
+	buf[len] = '\0';
+	t->node_ids[t->num_nodes] = node;
+	t->node_first[t->num_nodes] = t->num_cpus;
+	parse_cpulist(t, buf, allowed);
+	if (t->num_cpus > t->node_first[t->num_nodes])
+		t->num_nodes++;
+}
+
+/**
+ * @brief Puts every allowed CPU into a single node 0.
+ *
+ * @param t Pointer to the topology.
+ * @param allowed CPUs this process may run on.
+ */
+static void	load_fallback(t_topology *t, cpu_set_t *allowed)
+{
+	int	cpu;
+
+	t->node_ids[0] = 0;
+	t->node_first[0] = 0;
+	cpu = 0;
+	while (cpu < MAX_CPUS)
+	{
+		if (CPU_ISSET(cpu, allowed))
+		{
+			t->cpu_node[cpu] = 0;
+			t->cpus[t->num_cpus] = cpu;
+			t->num_cpus++;
+		}
+		cpu++;
+	}
+	t->num_nodes = 1;
+}
+
+/**
+ * @brief Discovers the CPUs and NUMA nodes available to this process.
+ *
+ * @param t Pointer to the topology to fill.
+ * @return int Returns EXIT_SUCCESS if at least one CPU was found, otherwise
+ * EXIT_FAILURE, in which case `num_cpus` is 0.
+ */
+int	load_topology(t_topology *t)
+{
+	cpu_set_t	allowed;
+	int			i;
+
+	t->num_cpus = 0;
+	t->num_nodes = 0;
+	i = 0;
+	while (i < MAX_CPUS)
+	{
+		t->cpu_node[i] = -1;
+		i++;
+	}
+	if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0)
+		return (EXIT_FAILURE);
+	i = 0;
+	while (i < MAX_NODES)
+	{
+		read_node(t, i, &allowed);
+		i++;
+	}
+	if (t->num_cpus == 0)
+		load_fallback(t, &allowed);
+	t->node_first[t->num_nodes] = t->num_cpus;
+	if (t->num_cpus == 0)
+		return (EXIT_FAILURE);
+	return (EXIT_SUCCESS);
+}
@@ -0,0 +1,159 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   trace.c                                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: imunaev- <imunaev-@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 10:04:12 by imunaev-          #+#    #+#             */
+/*   Updated: 2026/10/19 10:04:12 by imunaev-         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file trace.c
+ * @brief Setup and teardown of the `--trace` Chrome trace-event file.
+ *
+ * The file is a JSON object whose `traceEvents` array is streamed while
+ * the log flusher prints (see `trace_entries()`), so the run keeps only
+ * a few words per philosopher in memory. It opens in Perfetto or
+ * `chrome://tracing`.
+ */
+
+#include "philo.h"
+
+/**
+ * @brief Writes the start of the file and names the process and tracks.
+ *
+ * @param t Pointer to the trace writer.
+ */
+static void	trace_header(t_trace *t)
+{
+	int	i;
+
+	fprintf(t->out, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n"
+		"{\"ph\":\"M\",\"pid\":1,\"name\":\"process_name\","
+		"\"args\":{\"name\":\"philo\"}}");
+	i = 0;
+	while (i < t->num_philo)
+	{
+		fprintf(t->out, ",\n{\"ph\":\"M\",\"pid\":1,\"tid\":%d,"
+			"\"name\":\"thread_name\",\"args\":{\"name\":\"philo %d\"}}",
+			i + 1, i + 1);
+		t->tracks[i].slice = -1;
+		t->fork_by[i] = -1;
+		i++;
+	}
+}
+
+/**
+ * @brief Opens the `--trace` file and sets up the per-philosopher state.
+ *
+ * Every philosopher starts out thinking at time 0.
+ *
+ * @param env Pointer to the environment structure.
+ * @return int Returns EXIT_SUCCESS if the trace is off or ready, otherwise
+ * EXIT_FAILURE.
+ */
+int	alloc_trace(t_env *env)
+{
+	t_trace	*t;
+	int		n;
+
+	if (!env->opts.trace)
+		return (EXIT_SUCCESS);
+	n = env->cfg.num_philo;
+	t = calloc(1, sizeof(t_trace));
+	env->trace = t;
+	if (!t)
+		return (EXIT_FAILURE);
+	t->num_philo = n;
+	t->min_ms = env->opts.trace_min;
+	t->tracks = calloc(n, sizeof(t_trace_track));
+	t->fork_by = malloc(n * sizeof(int));
+	t->fork_at = calloc(n, sizeof(long));
+	t->batch = malloc(LOG_BUFFER_SIZE * sizeof(t_log_entry));
+	t->out = fopen(env->opts.trace, "w");
+	if (!t->tracks || !t->fork_by || !t->fork_at || !t->batch || !t->out)
+	{
+		print_error("Error: --trace: cannot open the trace file\n");
+		return (EXIT_FAILURE);
+	}
+	setvbuf(t->out, NULL, _IOFBF, 1 << 16);
+	trace_header(t);
+	return (EXIT_SUCCESS);
+}
+
+/**
+ * @brief Records the death of a philosopher for the trace.
+ *
+ * Thread safety:
+ * - Called once, by the monitor that ended the simulation; the fields
+ *   are read after every thread was joined.
+ *
+ * @param env Pointer to the environment structure.
+ * @param id Index of the philosopher that died.
+ * @param timestamp Time of death, relative to `start_time`.
+ */
+void	trace_died(t_env *env, int id, long timestamp)
+{
+	if (!env->trace)
+		return ;
+	env->trace->dead = id + 1;
+	env->trace->dead_at = timestamp;
+}
+
+/**
+ * @brief Ends every track at the last event and closes the array.
+ *
+ * @param t Pointer to the trace writer.
+ */
+static void	trace_end(t_trace *t)
+{
+	int	i;
+
+	if (t->dead_at > t->last)
+		t->last = t->dead_at;
+	i = 0;
+	while (i < t->num_philo)
+	{
+		trace_interval(t, i, t->last);
+		trace_slice(t, i);
+		i++;
+	}
+	if (t->dead)
+		fprintf(t->out, ",\n{\"ph\":\"i\",\"s\":\"t\",\"pid\":1,\"tid\":%d,"
+			"\"ts\":%ld,\"name\":\"died\"}", t->dead, t->dead_at * 1000);
+	fprintf(t->out, "\n]}\n");
+}
+
+/**
+ * @brief Finishes and closes the `--trace` file.
+ *
+ * Called after every thread was joined, also when the run failed to
+ * start, so the file is always valid JSON.
+ *
+ * @param env Pointer to the environment structure.
+ */
+void	free_trace(t_env *env)
+{
+	t_trace	*t;
+	int		err;
+
+	t = env->trace;
+	if (!t)
+		return ;
+	if (t->out)
+	{
+		trace_end(t);
+		err = ferror(t->out);
+		if (fclose(t->out) != 0 || err)
+			print_error("Error: --trace: writing the trace file failed\n");
+	}
+	free(t->tracks);
+	free(t->fork_by);
+	free(t->fork_at);
+	free(t->batch);
+	free(t);
+	env->trace = NULL;
+}
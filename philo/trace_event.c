@@ -0,0 +1,174 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   trace_event.c                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: imunaev- <imunaev-@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 10:04:12 by imunaev-          #+#    #+#             */
+/*   Updated: 2026/10/19 10:04:12 by imunaev-         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file trace_event.c
+ * @brief Conversion of log entries into Chrome trace events.
+ *
+ * Every philosopher is one track (`tid` = its number) of process 1. The
+ * status messages split its time into thinking, waiting for a fork (from
+ * the first fork taken to the meal), eating and sleeping intervals, which
+ * are written as complete (`X`) events as soon as they end. Intervals
+ * shorter than `trace_min` are merged into the slice before them, so long
+ * runs give files that trace viewers can still load. A meal that came
+ * after `trace_min` ms or more of hunger gets a flow event from the last
+ * meal of each neighbour it took a fork from.
+ */
+
+#include "philo.h"
+
+/**
+ * @brief Maps a status message to the interval it starts.
+ *
+ * @param status Status message of the philosopher.
+ * @param kind The interval in progress.
+ * @return int The `t_trace_kind`, `kind` for a second fork, or -1 for an
+ * unknown message.
+ */
+static int	trace_kind(const char *status, int kind)
+{
+	static const char *const	names[] = {"is thinking", "has taken a fork",
+		"is eating", "is sleeping", NULL};
+	int							i;
+
+	i = 0;
+	while (names[i] && ft_strncmp(status, names[i], 32) != 0)
+		i++;
+	if (!names[i])
+		return (-1);
+	if (i == TRACE_WAIT && kind != TRACE_THINK)
+		return (kind);
+	return (i);
+}
+
+/**
+ * @brief Writes the pending slice of a philosopher, if there is one.
+ *
+ * @param t Pointer to the trace writer.
+ * @param id Philosopher index.
+ */
+void	trace_slice(t_trace *t, int id)
+{
+	static const char *const	names[] = {"thinking", "waiting for fork",
+		"eating", "sleeping"};
+	t_trace_track				*tr;
+
+	tr = &t->tracks[id];
+	if (tr->slice < 0)
+		return ;
+	fprintf(t->out, ",\n{\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%ld,"
+		"\"dur\":%ld,\"name\":\"%s\"}", id + 1, tr->from * 1000,
+		(tr->to - tr->from) * 1000, names[tr->slice]);
+	tr->slice = -1;
+}
+
+/**
+ * @brief Ends the interval in progress of a philosopher at `to`.
+ *
+ * The interval extends the pending slice if it is of the same kind or
+ * shorter than `trace_min`; otherwise the pending slice is written and
+ * the interval becomes the new one. Empty intervals are dropped.
+ *
+ * @param t Pointer to the trace writer.
+ * @param id Philosopher index.
+ * @param to End of the interval.
+ */
+void	trace_interval(t_trace *t, int id, long to)
+{
+	t_trace_track	*tr;
+
+	tr = &t->tracks[id];
+	if (to == tr->since)
+		return ;
+	if (tr->slice >= 0
+		&& (tr->slice == tr->kind || to - tr->since < t->min_ms))
+	{
+		tr->to = to;
+		return ;
+	}
+	trace_slice(t, id);
+	tr->slice = tr->kind;
+	tr->from = tr->since;
+	tr->to = to;
+}
+
+/**
+ * @brief Records a meal on both forks of a philosopher and draws the
+ * handoffs that it waited for.
+ *
+ * @param t Pointer to the trace writer.
+ * @param id Philosopher index.
+ * @param ts Start of the meal.
+ */
+static void	trace_handoffs(t_trace *t, int id, long ts)
+{
+	int	fork;
+	int	i;
+
+	i = 0;
+	while (i < 2)
+	{
+		fork = (id + i) % t->num_philo;
+		if (t->fork_by[fork] >= 0 && t->fork_by[fork] != id
+			&& ts - t->tracks[id].hungry >= t->min_ms)
+		{
+			fprintf(t->out, ",\n{\"ph\":\"s\",\"id\":%ld,\"pid\":1,\"tid\":%d,"
+				"\"ts\":%ld,\"name\":\"fork\",\"cat\":\"fork\"},\n"
+				"{\"ph\":\"f\",\"bp\":\"e\",\"id\":%ld,\"pid\":1,\"tid\":%d,"
+				"\"ts\":%ld,\"name\":\"fork\",\"cat\":\"fork\"}", t->flows,
+				t->fork_by[fork] + 1, t->fork_at[fork] * 1000, t->flows,
+				id + 1, ts * 1000);
+			t->flows++;
+		}
+		t->fork_by[fork] = id;
+		t->fork_at[fork] = ts;
+		i++;
+	}
+}
+
+/**
+ * @brief Feeds a batch of flushed log entries to the trace.
+ *
+ * Thread safety:
+ * - Called by the log flusher only, on its copy of the batch and after it
+ *   released the log buffer mutex, so producers never wait on trace I/O.
+ *
+ * @param t Pointer to the trace writer.
+ * @param entries The flushed log entries.
+ * @param count Number of entries.
+ */
+void	trace_entries(t_trace *t, const t_log_entry *entries, int count)
+{
+	t_trace_track	*tr;
+	int				kind;
+	int				i;
+
+	i = 0;
+	while (i < count)
+	{
+		tr = &t->tracks[entries[i].id - 1];
+		kind = trace_kind(entries[i].status, tr->kind);
+		if (kind == TRACE_EAT)
+			trace_handoffs(t, entries[i].id - 1, entries[i].timestamp);
+		if (kind >= 0 && kind != tr->kind)
+		{
+			trace_interval(t, entries[i].id - 1, entries[i].timestamp);
+			tr->kind = kind;
+			tr->since = entries[i].timestamp;
+			if (kind == TRACE_THINK)
+				tr->hungry = tr->since;
+		}
+		if (entries[i].timestamp > t->last)
+			t->last = entries[i].timestamp;
+		i++;
+	}
+}
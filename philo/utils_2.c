@@ -0,0 +1,47 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   utils_2.c                                          :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: imunaev- <imunaev-@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/03/19 10:12:41 by imunaev-          #+#    #+#             */
+/*   Updated: 2025/03/19 10:12:41 by imunaev-         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file utils_2.c
+ * @brief Additional string helpers for the philosopher simulation.
+ *
+ * This file contains helpers used when parsing run-time options:
+ * - Bounded string comparison (`ft_strncmp`)
+ */
+
+#include "philo.h"
+
+/**
+ * @brief Compares at most `n` characters of two strings.
+ *
+ * Characters are compared as unsigned values, and the comparison stops
+ * at the first difference or at the end of either string.
+ *
+ * @param s1 The first string.
+ * @param s2 The second string.
+ * @param n The maximum number of characters to compare.
+ * @return int Zero if the strings match over `n` characters, otherwise the
+ * difference between the first mismatching characters.
+ */
+int	ft_strncmp(const char *s1, const char *s2, size_t n)
+{
+	size_t	i;
+
+	i = 0;
+	while (i < n && (s1[i] || s2[i]))
+	{
+		if (s1[i] != s2[i])
+			return ((unsigned char)s1[i] - (unsigned char)s2[i]);
+		i++;
+	}
+	return (0);
+}
@@ -0,0 +1,134 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   philo_verify.c                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: imunaev- <imunaev-@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 13:02:18 by imunaev-          #+#    #+#             */
+/*   Updated: 2026/10/19 13:02:18 by imunaev-         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file philo_verify.c
+ * @brief Entry point of `philo-verify`, the checker of `philo` output.
+ *
+ * Usage: `./philo | ./philo-verify [options] num die eat sleep [meals]`,
+ * with the arguments of the checked run; its leading `--` options are
+ * accepted, and all but `--scenario=FILE` ignored. A log redirected from
+ * a file is mapped, a pipe is read in `VERIFY_CHUNK` blocks. Violations
+ * go to stderr, the summary to stdout, and the exit status is 1 if any
+ * rule was broken.
+ */
+
+#include "philo_verify.h"
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/**
+ * @brief Returns a monotonic time in microseconds.
+ *
+ * @return long The current time.
+ */
+static long	now_us(void)
+{
+	struct timespec	ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (ts.tv_sec * 1000000L + ts.tv_nsec / 1000);
+}
+
+/**
+ * @brief Checks a log that arrives through a pipe.
+ *
+ * An incomplete last line is kept at the start of the buffer for the next
+ * read; a line longer than the whole buffer is checked in pieces.
+ *
+ * @param v Pointer to the verifier state.
+ * @param fd The input.
+ * @return size_t The number of bytes read.
+ */
+static size_t	verify_stream(t_verify *v, int fd)
+{
+	char	*buf;
+	size_t	kept;
+	size_t	used;
+	size_t	bytes;
+	ssize_t	r;
+
+	buf = malloc(VERIFY_CHUNK);
+	if (!buf)
+		return (0);
+	kept = 0;
+	bytes = 0;
+	r = read(fd, buf, VERIFY_CHUNK);
+	while (r > 0)
+	{
+		bytes += r;
+		used = verify_buffer(v, buf, kept + r, false);
+		if (used == 0 && kept + r == VERIFY_CHUNK)
+			used = verify_buffer(v, buf, kept + r, true);
+		kept = kept + r - used;
+		memmove(buf, buf + used, kept);
+		r = read(fd, buf + kept, VERIFY_CHUNK - kept);
+	}
+	verify_buffer(v, buf, kept, true);
+	free(buf);
+	return (bytes);
+}
+
+/**
+ * @brief Checks the log on standard input, mapping it if it is a file.
+ *
+ * @param v Pointer to the verifier state.
+ * @return size_t The size of the log in bytes.
+ */
+static size_t	verify_input(t_verify *v)
+{
+	struct stat	st;
+	void		*map;
+
+	if (fstat(0, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size == 0)
+		return (verify_stream(v, 0));
+	map = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, 0, 0);
+	if (map == MAP_FAILED)
+		return (verify_stream(v, 0));
+	madvise(map, st.st_size, MADV_SEQUENTIAL);
+	verify_buffer(v, map, st.st_size, true);
+	munmap(map, st.st_size);
+	return (st.st_size);
+}
+
+/**
+ * @brief Checks the log and prints the summary.
+ *
+ * @param ac Argument count.
+ * @param av Argument vector.
+ * @return int EXIT_SUCCESS if the log broke no rule, otherwise
+ * EXIT_FAILURE.
+ */
+int	main(int ac, char **av)
+{
+	t_verify	v;
+	size_t		bytes;
+	long		start;
+
+	memset(&v, 0, sizeof(v));
+	if (verify_init(&v, ac, av) == EXIT_FAILURE)
+	{
+		verify_free(&v);
+		print_error("Usage: ./philo | ./philo-verify [options] num die eat "
+			"sleep [meals]\n");
+		return (EXIT_FAILURE);
+	}
+	start = now_us();
+	bytes = verify_input(&v);
+	verify_finish(&v);
+	verify_summary(&v, bytes, now_us() - start);
+	verify_free(&v);
+	if (v.total)
+		return (EXIT_FAILURE);
+	return (EXIT_SUCCESS);
+}
@@ -0,0 +1,98 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   philo_verify.h                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: imunaev- <imunaev-@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 13:02:18 by imunaev-          #+#    #+#             */
+/*   Updated: 2026/10/19 13:02:18 by imunaev-         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file philo_verify.h
+ * @brief Types of `philo-verify`, the streaming checker of `philo` output.
+ */
+
+#ifndef PHILO_VERIFY_H
+# define PHILO_VERIFY_H
+
+# include "../philo.h"
+
+# define VERIFY_SLACK_MS 10
+# define VERIFY_SHOWN 10
+# define VERIFY_CHUNK 1048576
+
+/**
+ * @enum e_vstatus
+ * @brief Status messages of a log line, in the order they are matched.
+ */
+typedef enum e_vstatus
+{
+	VS_FORK,
+	VS_EAT,
+	VS_SLEEP,
+	VS_THINK,
+	VS_DIED
+}	t_vstatus;
+
+/**
+ * @enum e_violation
+ * @brief Kinds of violations, in the order of their messages.
+ */
+typedef enum e_violation
+{
+	V_SYNTAX,
+	V_ORDER,
+	V_FORKS,
+	V_NEIGHBOUR,
+	V_MISSED_DEATH,
+	V_EARLY_DEATH,
+	V_LATE_DEATH,
+	V_AFTER_DEATH,
+	V_UNFINISHED,
+	V_COUNT
+}	t_violation;
+
+/**
+ * @struct s_verify
+ * @brief State of the verifier.
+ *
+ * The run parameters come from the same arguments as `philo`, and its
+ * `--scenario` file if one is given, so die time, eat time and meal limit
+ * (-1 for none) are kept per philosopher. The per-philosopher state is
+ * kept in flat arrays indexed by philosopher too: start of the last meal
+ * (0 before the first), last timestamp, meals and forks taken since the
+ * last meal. `dead` is the number of the
+ * philosopher that died, or 0, and `death_delay` how long after its
+ * deadline the death was printed.
+ */
+typedef struct s_verify
+{
+	int		num_philo;
+	long	*die_time;
+	long	*eat_time;
+	int		*meals_limit;
+	long	*last_meal;
+	long	*last_ts;
+	int		*meals;
+	int		*forks;
+	long	line;
+	long	max_ts;
+	long	total_meals;
+	int		dead;
+	long	death_delay;
+	long	count[V_COUNT];
+	long	total;
+}	t_verify;
+
+int		verify_init(t_verify *v, int ac, char **av);
+void	verify_free(t_verify *v);
+void	verify_event(t_verify *v, int status, int id, long ts);
+size_t	verify_buffer(t_verify *v, const char *buf, size_t len, bool eof);
+void	violation(t_verify *v, t_violation kind, int id, long detail);
+void	verify_finish(t_verify *v);
+void	verify_summary(t_verify *v, size_t bytes, long us);
+
+#endif
@@ -0,0 +1,160 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   verify_args.c                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: imunaev- <imunaev-@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 18:02:51 by imunaev-          #+#    #+#             */
+/*   Updated: 2026/10/19 18:02:51 by imunaev-         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file verify_args.c
+ * @brief Run parameters of `philo-verify` and its per-philosopher tables.
+ *
+ * The timings start from the command-line values, like `philo`'s. With
+ * `--scenario=FILE` the same file is loaded and drawn with the same code
+ * (`scenario.c`), so every philosopher is checked against the die time,
+ * eat time and meal limit it had in the checked run.
+ */
+
+#include "philo_verify.h"
+
+/**
+ * @brief Allocates the per-philosopher arrays.
+ *
+ * @param v Pointer to the verifier state, with `num_philo` set.
+ * @return int Returns EXIT_SUCCESS if every array was allocated,
+ * otherwise EXIT_FAILURE.
+ */
+static int	alloc_tables(t_verify *v)
+{
+	v->die_time = calloc(v->num_philo, sizeof(long));
+	v->eat_time = calloc(v->num_philo, sizeof(long));
+	v->meals_limit = calloc(v->num_philo, sizeof(int));
+	v->last_meal = calloc(v->num_philo, sizeof(long));
+	v->last_ts = calloc(v->num_philo, sizeof(long));
+	v->meals = calloc(v->num_philo, sizeof(int));
+	v->forks = calloc(v->num_philo, sizeof(int));
+	if (!v->die_time || !v->eat_time || !v->meals_limit || !v->last_meal
+		|| !v->last_ts || !v->meals || !v->forks)
+		return (EXIT_FAILURE);
+	return (EXIT_SUCCESS);
+}
+
+/**
+ * @brief Loads the rules of a `--scenario` file.
+ *
+ * `apply_scenario()` only reads the rules from the environment, so a
+ * zeroed one holding them is enough.
+ *
+ * @param path The scenario file, or NULL for none.
+ * @return t_env* The environment holding the rules, or NULL on failure.
+ */
+static t_env	*load_rules(const char *path)
+{
+	t_env	*env;
+
+	env = calloc(1, sizeof(t_env));
+	if (!env)
+		return (NULL);
+	env->opts.scenario = path;
+	if (load_scenario(env) == EXIT_FAILURE)
+	{
+		free(env);
+		return (NULL);
+	}
+	return (env);
+}
+
+/**
+ * @brief Gives every philosopher the timings and meal limit it had in
+ * the checked run.
+ *
+ * Like `fillup_philos()`: the command-line values, overridden by the
+ * `--scenario` rules.
+ *
+ * @param v Pointer to the verifier state.
+ * @param ac Argument count, without the options.
+ * @param av Argument vector, without the options.
+ * @param env The environment holding the rules.
+ */
+static void	fill_timings(t_verify *v, int ac, char **av, t_env *env)
+{
+	t_philo	p;
+
+	p.id = 0;
+	while (p.id < v->num_philo)
+	{
+		p.die_time = ft_atoi(av[2]);
+		p.eat_time = ft_atoi(av[3]);
+		p.sleep_time = ft_atoi(av[4]);
+		p.meals_limit = -1;
+		if (ac == 6)
+			p.meals_limit = ft_atoi(av[5]);
+		if (env->scenario)
+			apply_scenario(env, &p);
+		v->die_time[p.id] = p.die_time;
+		v->eat_time[p.id] = p.eat_time;
+		v->meals_limit[p.id] = p.meals_limit;
+		p.id++;
+	}
+}
+
+/**
+ * @brief Reads the run parameters and sets up the per-philosopher tables.
+ *
+ * The leading `--` options of the checked run are accepted; all but
+ * `--scenario=FILE` are ignored.
+ *
+ * @param v Pointer to the zeroed verifier state.
+ * @param ac Argument count.
+ * @param av Argument vector.
+ * @return int Returns EXIT_SUCCESS on valid arguments, otherwise
+ * EXIT_FAILURE.
+ */
+int	verify_init(t_verify *v, int ac, char **av)
+{
+	const char	*scenario;
+	t_env		*env;
+	int			skip;
+
+	scenario = NULL;
+	skip = 0;
+	while (skip + 1 < ac && ft_strncmp(av[skip + 1], "--", 2) == 0)
+	{
+		if (ft_strncmp(av[skip + 1], "--scenario=", 11) == 0)
+			scenario = av[skip + 1] + 11;
+		skip++;
+	}
+	if (!validate_args(ac - skip, av + skip))
+		return (EXIT_FAILURE);
+	v->num_philo = ft_atoi(av[skip + 1]);
+	if (alloc_tables(v) == EXIT_FAILURE)
+		return (EXIT_FAILURE);
+	env = load_rules(scenario);
+	if (!env)
+		return (EXIT_FAILURE);
+	fill_timings(v, ac - skip, av + skip, env);
+	free_scenario(env);
+	free(env);
+	return (EXIT_SUCCESS);
+}
+
+/**
+ * @brief Frees the per-philosopher tables.
+ *
+ * @param v Pointer to the verifier state.
+ */
+void	verify_free(t_verify *v)
+{
+	free(v->die_time);
+	free(v->eat_time);
+	free(v->meals_limit);
+	free(v->last_meal);
+	free(v->last_ts);
+	free(v->meals);
+	free(v->forks);
+}
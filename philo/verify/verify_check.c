@@ -0,0 +1,120 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   verify_check.c                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: imunaev- <imunaev-@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 13:02:18 by imunaev-          #+#    #+#             */
+/*   Updated: 2026/10/19 13:02:18 by imunaev-         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file verify_check.c
+ * @brief The rules `philo-verify` checks each log line against.
+ *
+ * Lines of different philosophers may be printed slightly out of time
+ * order, so every rule only relies on the order of one philosopher's own
+ * lines and on bounds that hold whatever the interleaving. For example, a
+ * neighbour can only take a shared fork the holder's eat time after it
+ * started eating. Die and eat times are each philosopher's own (see
+ * `verify_args.c`).
+ */
+
+#include "philo_verify.h"
+
+/**
+ * @brief Checks that philosopher `i`, starting a meal at `ts`, does not
+ * overlap the last meal of its neighbour `j`.
+ *
+ * @param v Pointer to the verifier state.
+ * @param i Index of the philosopher that starts eating.
+ * @param j Index of the neighbour.
+ * @param ts Start of the meal.
+ */
+static void	check_neighbour(t_verify *v, int i, int j, long ts)
+{
+	if (j == i || v->meals[j] == 0)
+		return ;
+	if (ts - v->last_meal[j] < v->eat_time[j]
+		&& v->last_meal[j] - ts < v->eat_time[i])
+		violation(v, V_NEIGHBOUR, i + 1, j + 1);
+}
+
+/**
+ * @brief Checks a meal: two forks held, no neighbour eating, and the
+ * philosopher still alive.
+ *
+ * @param v Pointer to the verifier state.
+ * @param i Index of the philosopher.
+ * @param ts Start of the meal.
+ */
+static void	on_eat(t_verify *v, int i, long ts)
+{
+	if (v->forks[i] < 2)
+		violation(v, V_FORKS, i + 1, v->forks[i]);
+	v->forks[i] = 0;
+	if (ts - v->last_meal[i] > v->die_time[i] + VERIFY_SLACK_MS)
+		violation(v, V_MISSED_DEATH, i + 1,
+			ts - v->last_meal[i] - v->die_time[i]);
+	check_neighbour(v, i, (i + v->num_philo - 1) % v->num_philo, ts);
+	check_neighbour(v, i, (i + 1) % v->num_philo, ts);
+	v->last_meal[i] = ts;
+	v->meals[i]++;
+	v->total_meals++;
+}
+
+/**
+ * @brief Checks that a death is printed after the deadline, and at most
+ * `VERIFY_SLACK_MS` ms after it.
+ *
+ * @param v Pointer to the verifier state.
+ * @param i Index of the philosopher.
+ * @param ts Time of the death.
+ */
+static void	on_died(t_verify *v, int i, long ts)
+{
+	long	delay;
+
+	delay = ts - (v->last_meal[i] + v->die_time[i]);
+	if (delay < 0)
+		violation(v, V_EARLY_DEATH, i + 1, -delay);
+	else if (delay > VERIFY_SLACK_MS)
+		violation(v, V_LATE_DEATH, i + 1, delay);
+	if (!v->dead || delay > v->death_delay)
+		v->death_delay = delay;
+	v->dead = i + 1;
+}
+
+/**
+ * @brief Applies one parsed log line.
+ *
+ * @param v Pointer to the verifier state.
+ * @param status The `t_vstatus` of the line.
+ * @param id Philosopher number, from 1.
+ * @param ts Timestamp of the line.
+ */
+void	verify_event(t_verify *v, int status, int id, long ts)
+{
+	int	i;
+
+	i = id - 1;
+	if (v->dead)
+		violation(v, V_AFTER_DEATH, id, 0);
+	if (ts < v->last_ts[i])
+		violation(v, V_ORDER, id, v->last_ts[i] - ts);
+	v->last_ts[i] = ts;
+	if (ts > v->max_ts)
+		v->max_ts = ts;
+	if (status == VS_FORK)
+	{
+		v->forks[i]++;
+		if (v->forks[i] > 2)
+			violation(v, V_FORKS, id, v->forks[i]);
+	}
+	else if (status == VS_EAT)
+		on_eat(v, i, ts);
+	else if (status == VS_DIED)
+		on_died(v, i, ts);
+}
@@ -0,0 +1,134 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   verify_parse.c                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: imunaev- <imunaev-@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 13:02:18 by imunaev-          #+#    #+#             */
+/*   Updated: 2026/10/19 13:02:18 by imunaev-         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file verify_parse.c
+ * @brief Hand-written parser of `philo` log lines.
+ *
+ * A line is `<ms> <id> <status>`. Buffers are scanned in place with
+ * `memchr()`, without copying lines or allocating.
+ */
+
+#include "philo_verify.h"
+#include <string.h>
+
+/**
+ * @brief Parses a decimal number followed by a space.
+ *
+ * @param p Start of the number.
+ * @param end End of the line.
+ * @param out Where to store the number.
+ * @return const char* The character after the space, or NULL if there is
+ * no number of at most 18 digits followed by a space.
+ */
+static const char	*parse_long(const char *p, const char *end, long *out)
+{
+	const char	*start;
+
+	start = p;
+	*out = 0;
+	while (p < end && *p >= '0' && *p <= '9' && p - start < 18)
+	{
+		*out = *out * 10 + (*p - '0');
+		p++;
+	}
+	if (p == start || p == end || *p != ' ')
+		return (NULL);
+	return (p + 1);
+}
+
+/**
+ * @brief Matches the status message of a line.
+ *
+ * @param p Start of the message.
+ * @param end End of the line.
+ * @return int The `t_vstatus`, or -1 for an unknown message.
+ */
+static int	parse_status(const char *p, const char *end)
+{
+	static const char *const	names[] = {"has taken a fork", "is eating",
+		"is sleeping", "is thinking", "died", NULL};
+	static const size_t			lens[] = {16, 9, 11, 11, 4};
+	int							i;
+
+	i = 0;
+	while (names[i])
+	{
+		if ((size_t)(end - p) == lens[i] && memcmp(p, names[i], lens[i]) == 0)
+			return (i);
+		i++;
+	}
+	return (-1);
+}
+
+/**
+ * @brief Parses one line and applies it.
+ *
+ * @param v Pointer to the verifier state.
+ * @param p Start of the line.
+ * @param end End of the line, without the newline.
+ */
+static void	verify_line(t_verify *v, const char *p, const char *end)
+{
+	long	ts;
+	long	id;
+	int		status;
+
+	v->line++;
+	id = 0;
+	status = -1;
+	p = parse_long(p, end, &ts);
+	if (p)
+		p = parse_long(p, end, &id);
+	if (p)
+		status = parse_status(p, end);
+	if (status < 0 || id < 1 || id > v->num_philo)
+	{
+		violation(v, V_SYNTAX, 0, 0);
+		return ;
+	}
+	verify_event(v, status, id, ts);
+}
+
+/**
+ * @brief Checks every complete line of a buffer.
+ *
+ * @param v Pointer to the verifier state.
+ * @param buf The buffer.
+ * @param len Its length in bytes.
+ * @param eof Whether the input ends with this buffer, so that a last line
+ * without a newline is checked too.
+ * @return size_t The number of bytes consumed; the rest starts a line
+ * that continues in the next buffer.
+ */
+size_t	verify_buffer(t_verify *v, const char *buf, size_t len, bool eof)
+{
+	const char	*p;
+	const char	*end;
+	const char	*nl;
+
+	p = buf;
+	end = buf + len;
+	while (p < end)
+	{
+		nl = memchr(p, '\n', end - p);
+		if (!nl && !eof)
+			break ;
+		if (!nl)
+			nl = end;
+		verify_line(v, p, nl);
+		p = nl + 1;
+	}
+	if (p > end)
+		p = end;
+	return (p - buf);
+}
@@ -0,0 +1,122 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   verify_report.c                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: imunaev- <imunaev-@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 13:02:18 by imunaev-          #+#    #+#             */
+/*   Updated: 2026/10/19 13:02:18 by imunaev-         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file verify_report.c
+ * @brief Violation reporting and the final summary of `philo-verify`.
+ */
+
+#include "philo_verify.h"
+
+/**
+ * @brief Counts a violation and prints the first `VERIFY_SHOWN` ones.
+ *
+ * @param v Pointer to the verifier state.
+ * @param kind The rule that was broken.
+ * @param id Number of the philosopher, or 0 for a malformed line.
+ * @param detail The value shown in the message of `kind`.
+ */
+void	violation(t_verify *v, t_violation kind, int id, long detail)
+{
+	static const char *const	msgs[] = {"malformed line",
+		"timestamp went back by %ld ms",
+		"took %ld forks for a meal (expected 2)",
+		"ate while neighbour %ld was eating",
+		"ate %ld ms after its deadline without dying",
+		"died %ld ms before its deadline",
+		"death printed %ld ms after its deadline",
+		"printed after the death",
+		"stopped after %ld meals without a death"};
+
+	v->count[kind]++;
+	v->total++;
+	if (v->total > VERIFY_SHOWN)
+		return ;
+	fprintf(stderr, "line %ld: ", v->line);
+	if (id)
+		fprintf(stderr, "philosopher %d ", id);
+	fprintf(stderr, msgs[kind], detail);
+	fprintf(stderr, "\n");
+}
+
+/**
+ * @brief Applies the end-of-log rules when no death was printed.
+ *
+ * A philosopher with a meal limit must have reached it; one without may
+ * not have gone hungry past its deadline by the last line.
+ *
+ * @param v Pointer to the verifier state.
+ */
+void	verify_finish(t_verify *v)
+{
+	int	i;
+
+	if (v->dead)
+		return ;
+	i = 0;
+	while (i < v->num_philo)
+	{
+		if (v->meals_limit[i] >= 0 && v->meals[i] < v->meals_limit[i])
+			violation(v, V_UNFINISHED, i + 1, v->meals[i]);
+		else if (v->meals_limit[i] < 0 && v->max_ts - v->last_meal[i]
+			> v->die_time[i] + VERIFY_SLACK_MS)
+			violation(v, V_MISSED_DEATH, i + 1,
+				v->max_ts - v->last_meal[i] - v->die_time[i]);
+		i++;
+	}
+}
+
+/**
+ * @brief Prints how many violations of each kind were found.
+ *
+ * @param v Pointer to the verifier state.
+ */
+static void	print_counts(t_verify *v)
+{
+	static const char *const	names[] = {"malformed", "out of order",
+		"forks", "neighbours eating", "missed death", "early death",
+		"late death", "after death", "unfinished"};
+	int							k;
+
+	printf("violations: %ld", v->total);
+	k = 0;
+	while (k < V_COUNT)
+	{
+		if (v->count[k])
+			printf(", %s %ld", names[k], v->count[k]);
+		k++;
+	}
+	printf("\n");
+}
+
+/**
+ * @brief Prints the summary: volume and speed, meals, death and
+ * violations.
+ *
+ * @param v Pointer to the verifier state.
+ * @param bytes Size of the log in bytes.
+ * @param us Time spent checking it in microseconds.
+ */
+void	verify_summary(t_verify *v, size_t bytes, long us)
+{
+	if (us < 1)
+		us = 1;
+	printf("%ld lines, %.1f MB in %.3f s (%.0f MB/s)\n", v->line,
+		bytes / 1e6, us / 1e6, bytes / (double)us);
+	printf("%ld meals, ", v->total_meals);
+	if (v->dead)
+		printf("philosopher %d died, printed %ld ms after its deadline\n",
+			v->dead, v->death_delay);
+	else
+		printf("no death\n");
+	print_counts(v);
+}